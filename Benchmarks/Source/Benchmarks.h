@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+    
+    Benchmarks.h
+    Created: 16 Oct 2026 3:02:45pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../../Source/DSP/MultiBandEngine.h"
+
+namespace Benchmarks
+{
+/*
+ calls func() numRuns times and returns the fastest run in nanoseconds per sample.
+ pass samplesPerRun = 1 to get nanoseconds per call instead.
+ the fastest run is the one least disturbed by the rest of the machine.
+ */
+template<typename Func>
+double measureNsPerSample(Func&& func, size_t samplesPerRun, int numRuns = 50)
+{
+    //warm up caches and branch predictors
+    func();
+    
+    auto best = std::numeric_limits<double>::max();
+    for( int i = 0; i < numRuns; ++i )
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        func();
+        auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        best = juce::jmin(best, elapsed);
+    }
+    
+    return best * 1.0e9 / static_cast<double>(samplesPerRun);
+}
+
+/*
+ fills every channel of 'buffer' with uniform white noise in [-1, 1)
+ */
+template<typename SampleType>
+void fillWithNoise(juce::AudioBuffer<SampleType>& buffer, juce::Random& random)
+{
+    for( int ch = 0; ch < buffer.getNumChannels(); ++ch )
+    {
+        auto* samples = buffer.getWritePointer(ch);
+        for( int i = 0; i < buffer.getNumSamples(); ++i )
+            samples[i] = static_cast<SampleType>(random.nextFloat() * 2.f - 1.f);
+    }
+}
+
+/*
+ the parameters of one band, owned here instead of by an APVTS.
+ */
+struct BandParams
+{
+    juce::AudioParameterFloat attack { "attack", "Attack", 5.f, 500.f, 50.f };
+    juce::AudioParameterFloat release { "release", "Release", 5.f, 500.f, 250.f };
+    juce::AudioParameterFloat threshold { "threshold", "Threshold", SimpleMBComp::MIN_THRESHOLD, SimpleMBComp::MAX_DB, 0.f };
+    juce::AudioParameterFloat knee { "knee", "Knee", 0.f, 24.f, 0.f };
+    juce::AudioParameterChoice ratio { "ratio", "Ratio", Params::GetRatioChoiceNames(), 3 };
+    juce::AudioParameterBool bypassed { "bypassed", "Bypassed", false };
+    juce::AudioParameterBool mute { "mute", "Mute", false };
+    juce::AudioParameterBool solo { "solo", "Solo", false };
+    juce::AudioParameterBool sidechain { "sidechain", "Sidechain", false };
+    
+    void attachTo(CompressorBand& comp)
+    {
+        comp.attack = &attack;
+        comp.release = &release;
+        comp.threshold = &threshold;
+        comp.knee = &knee;
+        comp.ratio = &ratio;
+        comp.bypassed = &bypassed;
+        comp.mute = &mute;
+        comp.solo = &solo;
+        comp.sidechain = &sidechain;
+    }
+};
+
+/*
+ the global parameters of a snapshot, the bands are read by updateFromSnapshot().
+ */
+inline SimpleMBComp::ProcessingSnapshot makeSnapshot(size_t numBands,
+                                                     const SimpleMBComp::CrossoverFrequencies& frequencies,
+                                                     bool midSide = false)
+{
+    SimpleMBComp::ProcessingSnapshot snapshot;
+    snapshot.numBands = numBands;
+    snapshot.crossovers = frequencies;
+    snapshot.midSide = midSide;
+    
+    return snapshot;
+}
+
+/*
+ what processBlock() does with the parameters at the top of every block, for the benchmarks driving an engine directly.
+ 'snapshot' has to outlive the processing, the engine keeps reading it.
+ */
+inline void updateFromSnapshot(SimpleMBComp::ProcessingSnapshot& snapshot,
+                               SimpleMBComp::CompressorBands& compressors,
+                               SimpleMBComp::CompressorBands& sideCompressors,
+                               SimpleMBComp::MultiBandEngineBase& engine)
+{
+    snapshot.readBands(compressors, sideCompressors);
+    for( size_t i = 0; i < snapshot.numBands; ++i )
+    {
+        compressors[i].updateCompressorSettings(snapshot.bands[i]);
+        if( snapshot.midSide )
+            sideCompressors[i].updateCompressorSettings(snapshot.sideBands[i]);
+    }
+    
+    engine.updateState(snapshot);
+}
+
+/*
+ the sweeps shared by the processBlock and stage benchmarks
+ */
+static constexpr std::array<int, 10> SWEEP_BLOCK_SIZES { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+static constexpr std::array<double, 4> SWEEP_SAMPLE_RATES { 44100.0, 48000.0, 96000.0, 192000.0 };
+static constexpr std::array<int, 4> SWEEP_CHANNELS { 1, 2, 6, 16 };
+
+/*
+ short blocks are timed more often than long ones so every case takes about as long.
+ */
+inline int getNumRuns(int blockSize)
+{
+    return juce::jlimit(20, 2000, 65536 / blockSize);
+}
+
+/*
+ Solo and Mute are set on the lowest band only, Bypass on every band.
+ */
+enum class BandState
+{
+    Normal,
+    Solo,
+    Mute,
+    Bypass,
+};
+
+inline const char* getName(BandState state)
+{
+    switch( state )
+    {
+        case BandState::Normal: return "normal";
+        case BandState::Solo: return "solo";
+        case BandState::Mute: return "mute";
+        case BandState::Bypass: return "bypass";
+    }
+    
+    jassertfalse;
+    return "";
+}
+
+/*
+ every benchmark prints one line per case and returns false if a correctness check failed.
+ */
+bool runBlockSizeBenchmark();
+bool runCrossoverBenchmark();
+bool runEditorBenchmark();
+bool runIdleBenchmark();
+bool runIsaBenchmark();
+bool runLinearPhaseBenchmark();
+bool runLookaheadBenchmark();
+bool runCompressorBenchmark();
+bool runLayoutBenchmark();
+bool runMidSideBenchmark();
+bool runParallelBandsBenchmark();
+bool runPrecisionBenchmark();
+bool runProcessBlockBenchmark();
+bool runRealtimeBenchmark();
+bool runSidechainBenchmark();
+bool runStageBenchmark();
+bool runUpdateStateBenchmark();
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    BlockSizeBenchmark.cpp
+    Created: 17 Oct 2026 11:06:45pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+
+namespace Benchmarks
+{
+enum class BlockSizeMode
+{
+    Default,
+    MidSide,
+    LinearPhase,
+};
+
+const char* getName(BlockSizeMode mode)
+{
+    switch( mode )
+    {
+        case BlockSizeMode::Default: return "default";
+        case BlockSizeMode::MidSide: return "mid_side";
+        case BlockSizeMode::LinearPhase: return "linear_phase";
+    }
+
+    jassertfalse;
+    return "";
+}
+
+/*
+ renders 'input' in blocks of the given sizes, one after the other until the input runs out.
+ the processor is prepared for 'preparedBlockSize', whatever sizes it is then handed.
+ */
+juce::AudioBuffer<float> renderInBlocks(const juce::AudioBuffer<float>& input,
+                                        const std::vector<int>& blockSizes,
+                                        int preparedBlockSize,
+                                        BlockSizeMode mode,
+                                        double& nsPerSample)
+{
+    const auto numChannels = input.getNumChannels();
+
+    ProcessorOptions options;
+    options.blockSize = preparedBlockSize;
+    options.numChannels = numChannels;
+    options.midSide = mode == BlockSizeMode::MidSide;
+    options.linearPhase = mode == BlockSizeMode::LinearPhase;
+    auto prepared = makePreparedProcessor(options);
+    auto& processor = *prepared;
+
+    //every block is processed in place in a buffer of exactly its own size, the way hosts hand them over
+    juce::AudioBuffer<float> output(input);
+    juce::MidiBuffer midi;
+    std::vector<float*> channels(static_cast<size_t>(numChannels));
+
+    auto elapsed = 0.0;
+    auto start = 0;
+    for( size_t i = 0; start < output.getNumSamples(); ++i )
+    {
+        auto numSamples = juce::jmin(blockSizes[i % blockSizes.size()], output.getNumSamples() - start);
+        for( int ch = 0; ch < numChannels; ++ch )
+            channels[static_cast<size_t>(ch)] = output.getWritePointer(ch, start);
+
+        juce::AudioBuffer<float> block(channels.data(), numChannels, numSamples);
+
+        auto ticks = juce::Time::getHighResolutionTicks();
+        processor.processBlock(block, midi);
+        elapsed += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticks);
+
+        start += numSamples;
+    }
+
+    processor.releaseResources();
+
+    nsPerSample = elapsed * 1.0e9 / static_cast<double>(output.getNumSamples() * numChannels);
+    return output;
+}
+
+/*
+ the processor works through every block in tiles of a fixed size, so the block sizes the host
+ uses must not change a single sample of the output, and must never make it allocate.
+ random sizes from 0 up to well past what prepareToPlay() announced are held against a render in
+ fixed blocks of the announced size.
+ with SIMPLEMBCOMP_REALTIME_CHECKS (the RealtimeCheck configuration) any allocation or lock fails it too.
+ */
+bool runBlockSizeBenchmark()
+{
+    const auto numChannels = 2;
+    const auto numSamples = 48000 * 2;
+
+    juce::AudioBuffer<float> input(numChannels, numSamples);
+    juce::Random random(0x5eed);
+    fillWithNoise(input, random);
+
+    auto passed = true;
+
+    //the second size uses the parallel band path for every block of PARALLEL_CHUNK_SIZE or more
+    for( auto preparedBlockSize : { 512, static_cast<int>(SimpleMBComp::PARALLEL_CHUNK_SIZE) } )
+    {
+        std::vector<int> randomSizes;
+        for( int i = 0; i < 256; ++i )
+            randomSizes.push_back(random.nextInt(preparedBlockSize * 4 + 1));
+
+        //the odd ones out: nothing at all, a single sample, one sample either side of a tile
+        randomSizes.insert(randomSizes.begin(), { 0, 1, static_cast<int>(SimpleMBComp::TILE_SIZE) - 1, static_cast<int>(SimpleMBComp::TILE_SIZE) + 1 });
+
+        for( auto mode : { BlockSizeMode::Default, BlockSizeMode::MidSide, BlockSizeMode::LinearPhase } )
+        {
+            auto fixedNs = 0.0, randomNs = 0.0;
+            auto fixed = renderInBlocks(input, { preparedBlockSize }, preparedBlockSize, mode, fixedNs);
+
+            SimpleMBComp::RealtimeSafety::clearViolations();
+            auto varied = renderInBlocks(input, randomSizes, preparedBlockSize, mode, randomNs);
+            auto numViolations = SimpleMBComp::RealtimeSafety::getNumViolations();
+
+            auto identical = true;
+            for( int ch = 0; ch < numChannels; ++ch )
+                identical &= std::equal(fixed.getReadPointer(ch), fixed.getReadPointer(ch) + numSamples, varied.getReadPointer(ch));
+
+            auto ok = identical && numViolations == 0;
+            passed &= ok;
+
+            std::cout << "block_sizes"
+                      << " prepared=" << preparedBlockSize
+                      << " mode=" << getName(mode)
+                      << " fixed_ns_per_sample=" << fixedNs
+                      << " random_ns_per_sample=" << randomNs
+                      << " identical=" << (identical ? "yes" : "no")
+                      << " realtime_violations=" << numViolations
+                      << (SIMPLEMBCOMP_REALTIME_CHECKS ? "" : " (not checked in this configuration)")
+                      << (ok ? " ok" : " FAILED")
+                      << std::endl;
+
+            if( numViolations > 0 )
+                std::cout << SimpleMBComp::RealtimeSafety::describeViolations() << std::endl;
+        }
+    }
+
+    return passed;
+}
+}
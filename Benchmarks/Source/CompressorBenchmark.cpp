@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+    
+    CompressorBenchmark.cpp
+    Created: 16 Oct 2026 7:40:22pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/MultiBandEngine.h"
+
+namespace Benchmarks
+{
+/*
+ a steady level settles to the same point on the static curve in both compressors,
+ since a hard knee with the same threshold and ratio describes the same curve.
+ */
+template<typename Comp>
+float measureSettledLevelDb(Comp& compressor, const juce::dsp::ProcessSpec& spec, float inputLevel)
+{
+    juce::AudioBuffer<float> buffer(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+    
+    //a second of DC is plenty for a 250 ms release to settle
+    for( auto processed = 0.0; processed < spec.sampleRate; processed += buffer.getNumSamples() )
+    {
+        for( int ch = 0; ch < buffer.getNumChannels(); ++ch )
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), inputLevel, buffer.getNumSamples());
+        
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        compressor.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+    
+    return juce::Decibels::gainToDecibels(buffer.getSample(0, buffer.getNumSamples() - 1));
+}
+
+/*
+ SimpleMBComp::Compressor against juce::dsp::Compressor, one tile at a time like the bands run them.
+ fails if the two disagree about where a steady signal ends up.
+ */
+bool runCompressorBenchmark()
+{
+    const auto sampleRate = 48000.0;
+    auto passed = true;
+    
+    juce::Random random(0x5eed);
+    
+    for( auto numChannels : { 1, 2, 8 } )
+    {
+        const auto spec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+        
+        juce::dsp::Compressor<float> reference;
+        SimpleMBComp::Compressor<float> compressor;
+        
+        reference.prepare(spec);
+        compressor.prepare(spec);
+        
+        reference.setThreshold(-20.f);
+        compressor.setThreshold(-20.f);
+        reference.setRatio(4.f);
+        compressor.setRatioIndex(4); //4:1
+        reference.setAttack(10.f);
+        compressor.setAttack(10.f);
+        reference.setRelease(250.f);
+        compressor.setRelease(250.f);
+        
+        //0.5 is -6 dB, 14 dB over the threshold.  4:1 leaves 3.5 of those.
+        auto referenceDb = measureSettledLevelDb(reference, spec, 0.5f);
+        auto compressorDb = measureSettledLevelDb(compressor, spec, 0.5f);
+        auto settled = std::abs(referenceDb - compressorDb) < 0.01f;
+        passed &= settled;
+        
+        juce::AudioBuffer<float> noise(numChannels, static_cast<int>(SimpleMBComp::TILE_SIZE));
+        fillWithNoise(noise, random);
+        juce::AudioBuffer<float> buffer(numChannels, noise.getNumSamples());
+        
+        auto run = [&](auto& comp)
+        {
+            return [&]()
+            {
+                buffer.makeCopyOf(noise, true);
+                auto block = juce::dsp::AudioBlock<float>(buffer);
+                comp.process(juce::dsp::ProcessContextReplacing<float>(block));
+            };
+        };
+        
+        const auto samplesPerRun = static_cast<size_t>(noise.getNumSamples() * numChannels);
+        auto referenceNs = measureNsPerSample(run(reference), samplesPerRun, 1000);
+        auto compressorNs = measureNsPerSample(run(compressor), samplesPerRun, 1000);
+        
+        std::cout << "compressor"
+                  << " channels=" << numChannels
+                  << " tile=" << SimpleMBComp::TILE_SIZE
+                  << " rate=" << sampleRate
+                  << " reference_ns_per_sample=" << referenceNs
+                  << " compressor_ns_per_sample=" << compressorNs
+                  << " speedup=" << referenceNs / compressorNs
+                  << " reference_settled_db=" << referenceDb
+                  << " compressor_settled_db=" << compressorDb
+                  << " settled_match=" << (settled ? "yes" : "no")
+                  << std::endl;
+    }
+    
+    return passed;
+}
+}
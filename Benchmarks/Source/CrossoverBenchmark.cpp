@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+    
+    CrossoverBenchmark.cpp
+    Created: 16 Oct 2026 3:02:45pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/LinkwitzRileyFilterBank.h"
+
+namespace Benchmarks
+{
+/*
+ the crossover network as it was before LinkwitzRileyFilterBank:
+ one juce::dsp::LinkwitzRileyFilter per lowpass, highpass and allpass, one band at a time.
+ */
+template<size_t NBands>
+struct ReferenceCrossovers
+{
+    static constexpr size_t NumCrossovers = NBands - 1;
+    
+    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
+    using BandBlocks = std::array<juce::dsp::AudioBlock<float>, NBands>;
+    
+    std::array<Filter, NumCrossovers> lowpasses, highpasses;
+    std::array<std::array<Filter, NumCrossovers>, NBands> allpasses;
+    
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        for( size_t x = 0; x < NumCrossovers; ++x )
+        {
+            lowpasses[x].setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+            highpasses[x].setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+            lowpasses[x].prepare(spec);
+            highpasses[x].prepare(spec);
+            
+            for( auto& band : allpasses )
+            {
+                band[x].setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+                band[x].prepare(spec);
+            }
+        }
+    }
+    
+    void setCutoffFrequency(size_t x, float freq)
+    {
+        lowpasses[x].setCutoffFrequency(freq);
+        highpasses[x].setCutoffFrequency(freq);
+        for( auto& band : allpasses )
+            band[x].setCutoffFrequency(freq);
+    }
+    
+    void process(const juce::dsp::AudioBlock<const float>& input, BandBlocks& bands)
+    {
+        for( size_t x = 0; x < NumCrossovers; ++x )
+        {
+            const auto source = x == 0 ? input : juce::dsp::AudioBlock<const float>(bands[x]);
+            
+            auto highCtx = juce::dsp::ProcessContextNonReplacing<float>(source, bands[x + 1]);
+            highpasses[x].process(highCtx);
+            
+            if( x == 0 )
+            {
+                auto lowCtx = juce::dsp::ProcessContextNonReplacing<float>(source, bands[x]);
+                lowpasses[x].process(lowCtx);
+            }
+            else
+            {
+                auto lowCtx = juce::dsp::ProcessContextReplacing<float>(bands[x]);
+                lowpasses[x].process(lowCtx);
+            }
+            
+            auto allpassCtx = juce::dsp::ProcessContextReplacing<float>(bands[x]);
+            for( size_t above = x + 1; above < NumCrossovers; ++above )
+                allpasses[x][above].process(allpassCtx);
+        }
+    }
+};
+
+template<size_t NBands>
+bool runCrossoverCase(int numChannels, int blockSize, double sampleRate)
+{
+    const std::array<float, 7> frequencies { 400.f, 2000.f, 5000.f, 8000.f, 11000.f, 14000.f, 17000.f };
+    const auto spec = juce::dsp::ProcessSpec { sampleRate,
+                                               static_cast<juce::uint32>(blockSize),
+                                               static_cast<juce::uint32>(numChannels) };
+    
+    ReferenceCrossovers<NBands> reference;
+    SimpleMBComp::LinkwitzRileyFilterBank<float, NBands> bank;
+    reference.prepare(spec);
+    bank.prepare(spec);
+    
+    for( size_t x = 0; x < NBands - 1; ++x )
+    {
+        reference.setCutoffFrequency(x, frequencies[x]);
+        bank.setCutoffFrequency(x, frequencies[x]);
+    }
+    
+    juce::AudioBuffer<float> input(numChannels, blockSize);
+    std::array<juce::AudioBuffer<float>, NBands> referenceBuffers, bankBuffers;
+    std::array<juce::dsp::AudioBlock<float>, NBands> referenceBands, bankBands;
+    for( size_t b = 0; b < NBands; ++b )
+    {
+        referenceBuffers[b].setSize(numChannels, blockSize);
+        bankBuffers[b].setSize(numChannels, blockSize);
+        referenceBands[b] = juce::dsp::AudioBlock<float>(referenceBuffers[b]);
+        bankBands[b] = juce::dsp::AudioBlock<float>(bankBuffers[b]);
+    }
+    
+    juce::Random random(0x5eed);
+    const auto inputBlock = juce::dsp::AudioBlock<const float>(input);
+    
+    /*
+     both networks see the same noise for a few seconds.
+     the outputs may only differ by floating point contraction.
+     */
+    auto maxError = 0.f;
+    const auto numCheckBlocks = static_cast<int>(2.0 * sampleRate) / blockSize + 1;
+    for( int i = 0; i < numCheckBlocks; ++i )
+    {
+        fillWithNoise(input, random);
+        reference.process(inputBlock, referenceBands);
+        bank.process(inputBlock, bankBands);
+        
+        for( size_t b = 0; b < NBands; ++b )
+        {
+            for( int ch = 0; ch < numChannels; ++ch )
+            {
+                auto* ref = referenceBuffers[b].getReadPointer(ch);
+                auto* out = bankBuffers[b].getReadPointer(ch);
+                for( int s = 0; s < blockSize; ++s )
+                    maxError = juce::jmax(maxError, std::abs(ref[s] - out[s]));
+            }
+        }
+    }
+    
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto referenceNs = measureNsPerSample([&]() { reference.process(inputBlock, referenceBands); }, samplesPerRun);
+    auto bankNs = measureNsPerSample([&]() { bank.process(inputBlock, bankBands); }, samplesPerRun);
+    
+    static constexpr float tolerance = 1.0e-5f;
+    const auto passed = maxError <= tolerance;
+    
+    std::cout << "crossover"
+              << " bands=" << NBands
+              << " channels=" << numChannels
+              << " block=" << blockSize
+              << " rate=" << sampleRate
+              << " juce_ns_per_sample=" << referenceNs
+              << " bank_ns_per_sample=" << bankNs
+              << " speedup=" << referenceNs / bankNs
+              << " max_error=" << maxError
+              << (passed ? " ok" : " FAILED")
+              << std::endl;
+    
+    return passed;
+}
+
+bool runCrossoverBenchmark()
+{
+    auto passed = true;
+    for( auto numChannels : { 1, 2 } )
+    {
+        passed &= runCrossoverCase<2>(numChannels, 512, 48000.0);
+        passed &= runCrossoverCase<3>(numChannels, 512, 48000.0);
+        passed &= runCrossoverCase<5>(numChannels, 512, 48000.0);
+        passed &= runCrossoverCase<8>(numChannels, 512, 48000.0);
+    }
+    
+    return passed;
+}
+}
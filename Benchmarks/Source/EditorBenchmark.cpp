@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+    
+    EditorBenchmark.cpp
+    Created: 17 Oct 2026 5:12:37pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+#include "RegressionGate.h"
+#include "../../Source/PluginEditor.h"
+
+namespace Benchmarks
+{
+/*
+ what the message thread does on one timer tick, without a message loop to drive it.
+ */
+void runTimerCallbacks(juce::Component& component)
+{
+    if( auto* timer = dynamic_cast<juce::Timer*>(&component) )
+        timer->timerCallback();
+    
+    for( auto* child : component.getChildren() )
+        runTimerCallbacks(*child);
+}
+
+/*
+ one editor frame at 60 Hz: the timers pull the meters, gain reduction and analyzer data
+ and build the analyzer paths, then the whole editor is painted into an image.
+ the editor is never put on the desktop, so this runs without a display.
+ the processor is fed a frame's worth of audio between frames, untimed, so the analyzer always has new data.
+ */
+bool runEditorBenchmark()
+{
+    const auto sampleRate = 48000.0;
+    const auto blockSize = 400;
+    const auto blocksPerFrame = 2;
+    const auto numChannels = 2;
+    const auto numFrames = 300;
+    
+    ProcessorOptions options;
+    options.sampleRate = sampleRate;
+    options.blockSize = blockSize;
+    options.numChannels = numChannels;
+    
+    //the bands that aren't in use compress too, in case the band count gets changed from the editor
+    auto prepared = makePreparedProcessor(options, [&options](auto& processor)
+    {
+        for( const auto& band : Params::GetBandParams() )
+            setParameter(processor.apvts, band.at(Params::BandNames::Threshold), options.thresholdDb);
+    });
+    auto& processor = *prepared;
+    
+    std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditorIfNeeded());
+    editor->setVisible(true);
+    
+    juce::Image image(juce::Image::ARGB, editor->getWidth(), editor->getHeight(), true);
+    juce::Graphics g(image);
+    
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::Random random(0x5eed);
+    juce::MidiBuffer midi;
+    
+    auto bestTimers = std::numeric_limits<double>::max();
+    auto bestPaint = std::numeric_limits<double>::max();
+    for( int frame = 0; frame < numFrames; ++frame )
+    {
+        for( int i = 0; i < blocksPerFrame; ++i )
+        {
+            fillWithNoise(buffer, random);
+            processor.processBlock(buffer, midi);
+        }
+        
+        auto start = juce::Time::getHighResolutionTicks();
+        runTimerCallbacks(*editor);
+        auto painted = juce::Time::getHighResolutionTicks();
+        editor->paintEntireComponent(g, false);
+        auto end = juce::Time::getHighResolutionTicks();
+        
+        //the first frames build the analyzer paths from nothing, they don't count
+        if( frame < 10 )
+            continue;
+        
+        bestTimers = juce::jmin(bestTimers, juce::Time::highResolutionTicksToSeconds(painted - start));
+        bestPaint = juce::jmin(bestPaint, juce::Time::highResolutionTicksToSeconds(end - painted));
+    }
+    
+    editor.reset();
+    processor.releaseResources();
+    
+    const auto timersUs = bestTimers * 1.0e6;
+    const auto paintUs = bestPaint * 1.0e6;
+    
+    juce::String name;
+    name << "editor_frame width=" << image.getWidth() << " height=" << image.getHeight();
+    
+    record(name, timersUs + paintUs);
+    
+    std::cout << name
+              << " timers_us=" << timersUs
+              << " paint_us=" << paintUs
+              << " us_per_frame=" << timersUs + paintUs
+              << std::endl;
+    
+    //nothing to check, only to time
+    return true;
+}
+}
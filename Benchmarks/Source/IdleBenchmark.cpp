@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    IdleBenchmark.cpp
+    Created: 18 Oct 2026 10:21:14am
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+
+namespace Benchmarks
+{
+/*
+ what one processor made of a second of noise, four seconds of digital silence and another second of noise.
+ */
+struct IdleRender
+{
+    std::vector<float> samples;
+    size_t numIdleBlocks = 0;
+    double silentNsPerSample = 0.0;
+    double tailSeconds = 0.0;
+};
+
+IdleRender renderWithSilence(bool idleEnabled, bool linearPhase, float releaseMs)
+{
+    const auto sampleRate = 48000.0;
+    const auto blockSize = 512;
+    const auto numChannels = 2;
+
+    ProcessorOptions options;
+    options.sampleRate = sampleRate;
+    options.blockSize = blockSize;
+    options.numChannels = numChannels;
+    options.linearPhase = linearPhase;
+    auto prepared = makePreparedProcessor(options, [&](auto& processor)
+    {
+        processor.setIdleEnabled(idleEnabled);
+        for( size_t band = 0; band < options.numBands; ++band )
+            setParameter(processor.apvts, Params::GetBandParams()[band].at(Params::BandNames::Release), releaseMs);
+    });
+    auto& processor = *prepared;
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::Random random(0x5eed);
+    juce::MidiBuffer midi;
+
+    IdleRender render;
+    render.tailSeconds = processor.getTailLengthSeconds();
+
+    auto renderSeconds = [&](double seconds, bool silent)
+    {
+        for( auto processed = 0.0; processed < sampleRate * seconds; processed += blockSize )
+        {
+            if( silent )
+                buffer.clear();
+            else
+                fillWithNoise(buffer, random);
+
+            processor.processBlock(buffer, midi);
+            render.numIdleBlocks += processor.isIdle() ? 1 : 0;
+            for( int ch = 0; ch < numChannels; ++ch )
+                render.samples.insert(render.samples.end(), buffer.getReadPointer(ch), buffer.getReadPointer(ch) + blockSize);
+        }
+    };
+
+    renderSeconds(1.0, false);
+    renderSeconds(4.0, true);
+
+    //still silent, so the idle one stays idle while it is timed
+    render.silentNsPerSample = measureNsPerSample([&]()
+    {
+        buffer.clear();
+        processor.processBlock(buffer, midi);
+    }, static_cast<size_t>(blockSize * numChannels));
+
+    renderSeconds(1.0, false);
+
+    processor.releaseResources();
+    return render;
+}
+
+/*
+ once the input has been silent for longer than the tail the processor resets itself and skips everything.
+ by then the filters and envelopes have decayed to what the reset leaves, so the noise coming back
+ has to render the same as it does through a processor that kept running the whole time.
+ the idle one has to actually go idle, and its tail has to cover the longest release.
+ */
+bool runIdleBenchmark()
+{
+    auto passed = true;
+
+    for( auto linearPhase : { false, true } )
+    {
+        for( auto releaseMs : { 50.f, 500.f } )
+        {
+            auto running = renderWithSilence(false, linearPhase, releaseMs);
+            auto idling = renderWithSilence(true, linearPhase, releaseMs);
+
+            auto largest = 1.f, error = 0.f;
+            for( size_t i = 0; i < running.samples.size(); ++i )
+            {
+                largest = juce::jmax(largest, std::abs(running.samples[i]));
+                error = juce::jmax(error, std::abs(running.samples[i] - idling.samples[i]));
+            }
+
+            auto relativeError = error / largest;
+            auto wentIdle = idling.numIdleBlocks > 0 && running.numIdleBlocks == 0;
+            auto coversRelease = idling.tailSeconds >= 5.0 * releaseMs / 1000.0;
+            auto ok = relativeError <= 1.0e-4f && wentIdle && coversRelease;
+            passed &= ok;
+
+            std::cout << "idle"
+                      << " crossover=" << (linearPhase ? "linear_phase" : "minimum_phase")
+                      << " release_ms=" << releaseMs
+                      << " tail_seconds=" << idling.tailSeconds
+                      << " idle_blocks=" << idling.numIdleBlocks
+                      << " running_silence_ns_per_sample=" << running.silentNsPerSample
+                      << " idle_silence_ns_per_sample=" << idling.silentNsPerSample
+                      << " speedup=" << running.silentNsPerSample / idling.silentNsPerSample
+                      << " relative_error=" << relativeError
+                      << (ok ? " ok" : " FAILED")
+                      << std::endl;
+        }
+    }
+
+    return passed;
+}
+}
@@ -0,0 +1,308 @@
+/*
+  ==============================================================================
+
+    IsaBenchmark.cpp
+    Created: 17 Oct 2026 7:52:31pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+#include "../../Source/DSP/Kernels.h"
+
+namespace Benchmarks
+{
+using SimpleMBComp::Kernels::Isa;
+using SimpleMBComp::Kernels::KernelSet;
+
+constexpr std::array<Isa, 3> ALL_ISAS { Isa::Generic, Isa::AVX2, Isa::AVX512 };
+
+/*
+ the variants may contract a * b + c into one FMA, which rounds once instead of twice.
+ that is the only difference allowed, so the tolerance is a few ulps of the largest value.
+ */
+template<typename SampleType>
+constexpr SampleType getTolerance()
+{
+    return std::is_same_v<SampleType, double> ? static_cast<SampleType>(1.0e-12) : static_cast<SampleType>(2.0e-5f);
+}
+
+//the largest difference between 'a' and 'b', relative to the largest magnitude in either
+template<typename SampleType>
+SampleType getRelativeError(const std::vector<SampleType>& a, const std::vector<SampleType>& b)
+{
+    jassert(a.size() == b.size());
+
+    auto largest = static_cast<SampleType>(1);
+    auto error = static_cast<SampleType>(0);
+    for( size_t i = 0; i < a.size(); ++i )
+    {
+        //NaN must never compare as close
+        if( std::isnan(a[i]) != std::isnan(b[i]) )
+            return std::numeric_limits<SampleType>::infinity();
+
+        largest = juce::jmax(largest, std::abs(a[i]), std::abs(b[i]));
+        error = juce::jmax(error, std::abs(a[i] - b[i]));
+    }
+
+    return error / largest;
+}
+
+/*
+ what one kernel wrote, so every variant can be held against the generic one
+ */
+template<typename SampleType>
+struct KernelOutput
+{
+    std::vector<SampleType> samples;
+    double nsPerSample = 0.0;
+};
+
+template<typename SampleType>
+std::vector<SampleType> makeNoise(size_t numSamples, juce::Random& random, float scale = 1.f)
+{
+    std::vector<SampleType> noise(numSamples);
+    for( auto& x : noise )
+        x = static_cast<SampleType>((random.nextFloat() * 2.f - 1.f) * scale);
+
+    return noise;
+}
+
+/*
+ runs every kernel of 'kernels' except the crossover over the same input.
+ the crossover is covered by the whole processor below, its state is too involved to set up by hand.
+ */
+template<typename SampleType>
+std::map<juce::String, KernelOutput<SampleType>> runKernels(const KernelSet& kernels, size_t numSamples)
+{
+    const auto& table = kernels.get<SampleType>();
+    std::map<juce::String, KernelOutput<SampleType>> outputs;
+
+    juce::Random random(0x5eed);
+    const auto input = makeNoise<SampleType>(numSamples, random);
+    const auto other = makeNoise<SampleType>(numSamples, random, 0.25f);
+
+    {
+        auto& out = outputs["copy_and_measure"];
+        std::vector<SampleType> dest(other);
+        SimpleMBComp::Kernels::SampleLevels<SampleType> levels;
+        out.nsPerSample = measureNsPerSample([&]() { levels = table.copyAndMeasure(dest.data(), input.data(), numSamples, true); }, numSamples);
+
+        //adding checks the other branch, the levels don't depend on it
+        dest = other;
+        levels = table.copyAndMeasure(dest.data(), input.data(), numSamples, false);
+        out.samples = dest;
+        out.samples.push_back(levels.peak);
+        out.samples.push_back(levels.sumOfSquares);
+    }
+
+    {
+        auto& out = outputs["add_mid_side"];
+        std::vector<SampleType> left(other), right(input);
+        SimpleMBComp::Kernels::SampleLevels<SampleType> midLevels, sideLevels;
+        out.nsPerSample = measureNsPerSample([&]()
+        {
+            table.addMidSide(left.data(), right.data(), input.data(), other.data(), numSamples, true, midLevels, sideLevels);
+        }, numSamples);
+
+        left = other;
+        right = input;
+        table.addMidSide(left.data(), right.data(), input.data(), other.data(), numSamples, false, midLevels, sideLevels);
+        out.samples = left;
+        out.samples.insert(out.samples.end(), right.begin(), right.end());
+        out.samples.insert(out.samples.end(), { midLevels.peak, midLevels.sumOfSquares, sideLevels.peak, sideLevels.sumOfSquares });
+    }
+
+    /*
+     2 channels through the whole compressor: curve, envelope and gain.
+     a soft knee around -12 dB, so the noise crosses every region of the curve.
+     the lowest level is the one SimpleMBComp::Compressor uses.
+     */
+    {
+        const auto curve = SimpleMBComp::Kernels::CompressorCurve<SampleType> { static_cast<SampleType>(-12),
+                                                                               static_cast<SampleType>(6),
+                                                                               static_cast<SampleType>(0.75),
+                                                                               static_cast<SampleType>(1.0e-5) };
+        const auto numLanes = static_cast<size_t>(SimpleMBComp::lanesPerVector<SampleType>);
+        const auto attackStep = static_cast<SampleType>(0.02), releaseStep = static_cast<SampleType>(0.001);
+
+        std::vector<SampleType> reduction(numSamples * 2), envelope(numLanes), lanes(numLanes), gains(numSamples * 2);
+        std::array<SampleType*, 2> rows { reduction.data(), reduction.data() + numSamples };
+
+        auto compress = [&]()
+        {
+            std::fill(envelope.begin(), envelope.end(), static_cast<SampleType>(0));
+            table.computeReduction(input.data(), rows[0], numSamples, curve);
+            table.computeReduction(other.data(), rows[1], numSamples, curve);
+            table.smoothReduction(rows.data(), 2, numSamples, envelope.data(), lanes.data(), numLanes, attackStep, releaseStep);
+            table.applyReduction(rows[0], input.data(), gains.data(), numSamples);
+            table.reductionToGain(rows[1], gains.data() + numSamples, numSamples);
+        };
+
+        auto& out = outputs["compressor"];
+        out.nsPerSample = measureNsPerSample(compress, numSamples * 2);
+        compress();
+        out.samples = reduction;
+        out.samples.insert(out.samples.end(), gains.begin(), gains.end());
+    }
+
+    if constexpr( std::is_same_v<SampleType, float> )
+    {
+        //magnitudes like the analyzer's, with the odd non-finite one it has to cope with
+        auto magnitudes = makeNoise<float>(numSamples, random, 64.f);
+        magnitudes[1] = std::numeric_limits<float>::infinity();
+        magnitudes[2] = std::numeric_limits<float>::quiet_NaN();
+        magnitudes[3] = 0.f;
+
+        std::vector<float> decibels;
+        auto& out = outputs["fft_to_db"];
+        out.nsPerSample = measureNsPerSample([&]()
+        {
+            decibels = magnitudes;
+            kernels.magnitudesToDecibels(decibels.data(), numSamples, static_cast<float>(numSamples), -48.f);
+        }, numSamples);
+        out.samples = decibels;
+    }
+
+    return outputs;
+}
+
+template<typename SampleType>
+bool compareKernels(const char* precision, size_t numSamples)
+{
+    const auto reference = runKernels<SampleType>(*SimpleMBComp::Kernels::getGenericKernels(), numSamples);
+    auto passed = true;
+
+    for( auto isa : ALL_ISAS )
+    {
+        auto* kernels = SimpleMBComp::Kernels::getKernels(isa);
+        if( kernels == nullptr )
+        {
+            std::cout << "isa kernel=all isa=" << SimpleMBComp::Kernels::getName(isa) << " skipped, not supported here" << std::endl;
+            continue;
+        }
+
+        for( const auto& [name, output] : runKernels<SampleType>(*kernels, numSamples) )
+        {
+            const auto& expected = reference.at(name);
+            auto error = getRelativeError(output.samples, expected.samples);
+            auto matches = error <= getTolerance<SampleType>();
+            passed &= matches;
+
+            std::cout << "isa kernel=" << name
+                      << " isa=" << SimpleMBComp::Kernels::getName(isa)
+                      << " precision=" << precision
+                      << " samples=" << numSamples
+                      << " ns_per_sample=" << output.nsPerSample
+                      << " speedup=" << expected.nsPerSample / output.nsPerSample
+                      << " relative_error=" << error
+                      << (matches ? " ok" : " FAILED")
+                      << std::endl;
+        }
+    }
+
+    return passed;
+}
+
+/*
+ the whole plugin once per variant: crossovers, compressors and the band sum all go through the kernels.
+ every variant has to render what the generic one renders.
+ */
+std::vector<float> renderProcessor(Isa isa, bool midSide, double& nsPerSample)
+{
+    const auto blockSize = 512;
+    const auto sampleRate = 48000.0;
+
+    SimpleMBComp::Kernels::setActiveIsa(isa);
+
+    ProcessorOptions options;
+    options.sampleRate = sampleRate;
+    options.blockSize = blockSize;
+    options.midSide = midSide;
+    auto prepared = makePreparedProcessor(options);
+    auto& processor = *prepared;
+
+    juce::AudioBuffer<float> noise(2, blockSize), buffer(2, blockSize);
+    juce::Random random(0x5eed);
+    juce::MidiBuffer midi;
+
+    //a quarter of a second, so the parameter fades finish and the envelopes move
+    std::vector<float> rendered;
+    for( auto processed = 0.0; processed < sampleRate * 0.25; processed += blockSize )
+    {
+        fillWithNoise(buffer, random);
+        processor.processBlock(buffer, midi);
+        for( int ch = 0; ch < 2; ++ch )
+            rendered.insert(rendered.end(), buffer.getReadPointer(ch), buffer.getReadPointer(ch) + blockSize);
+    }
+
+    fillWithNoise(noise, random);
+    nsPerSample = measureNsPerSample([&]()
+    {
+        buffer.makeCopyOf(noise, true);
+        processor.processBlock(buffer, midi);
+    }, static_cast<size_t>(blockSize * 2));
+
+    processor.releaseResources();
+    return rendered;
+}
+
+bool compareProcessors(bool midSide)
+{
+    auto referenceNs = 0.0;
+    const auto reference = renderProcessor(Isa::Generic, midSide, referenceNs);
+    auto passed = true;
+
+    for( auto isa : ALL_ISAS )
+    {
+        if( SimpleMBComp::Kernels::getKernels(isa) == nullptr )
+            continue;
+
+        auto ns = 0.0;
+        auto error = getRelativeError(renderProcessor(isa, midSide, ns), reference);
+
+        //the compressor feeds the rounding differences back through the envelope, so allow more here
+        auto matches = error <= 1.0e-4f;
+        passed &= matches;
+
+        std::cout << "isa process_block"
+                  << " isa=" << SimpleMBComp::Kernels::getName(isa)
+                  << " stereo=" << (midSide ? "mid_side" : "left_right")
+                  << " ns_per_sample=" << ns
+                  << " speedup=" << referenceNs / ns
+                  << " relative_error=" << error
+                  << (matches ? " ok" : " FAILED")
+                  << std::endl;
+    }
+
+    return passed;
+}
+
+/*
+ every kernel variant this CPU can run against the generic one.
+ fails if any variant computes something different, beyond what FMA contraction explains.
+ leaves the variant that was active before running.
+ */
+bool runIsaBenchmark()
+{
+    const auto active = SimpleMBComp::Kernels::getActiveKernels().isa;
+    std::cout << "isa active=" << SimpleMBComp::Kernels::getName(active) << std::endl;
+
+    auto passed = true;
+
+    //odd lengths, so every remainder loop runs too
+    for( size_t numSamples : { size_t(64), size_t(1023) } )
+    {
+        passed &= compareKernels<float>("float", numSamples);
+        passed &= compareKernels<double>("double", numSamples);
+    }
+
+    passed &= compareProcessors(false);
+    passed &= compareProcessors(true);
+
+    SimpleMBComp::Kernels::setActiveIsa(active);
+    return passed;
+}
+}
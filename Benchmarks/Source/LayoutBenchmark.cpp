@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+    
+    LayoutBenchmark.cpp
+    Created: 16 Oct 2026 11:14:52pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+namespace Benchmarks
+{
+/*
+ the band path on every bus width from mono to 16 channels.
+ channels share SIMD lanes in the crossovers and the compressor envelopes,
+ so the cost per channel should drop as the bus gets wider.
+ every channel gets the same input, so every channel has to come out identical.
+ */
+bool runLayoutCase(const char* layoutName, int numChannels)
+{
+    static constexpr size_t NumBands = 3;
+    const auto sampleRate = 48000.0;
+    const auto blockSize = 512;
+    
+    std::array<BandParams, NumBands> params;
+    SimpleMBComp::CompressorBands compressors, sideCompressors;
+    SimpleMBComp::BandBuffers buffers;
+    SimpleMBComp::LinearPhaseCrossovers linearPhase;
+    SimpleMBComp::MultiBandEngine<NumBands> engine { compressors, sideCompressors, buffers, linearPhase };
+    
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+    for( size_t i = 0; i < NumBands; ++i )
+    {
+        params[i].threshold = -18.f;
+        params[i].attachTo(compressors[i]);
+        
+        compressors[i].prepare<float>(tileSpec);
+        buffers.floats[i].setSize(numChannels, static_cast<int>(SimpleMBComp::TILE_SIZE));
+    }
+    
+    engine.prepare(tileSpec);
+    auto snapshot = makeSnapshot(NumBands, { 400.f, 2000.f });
+    updateFromSnapshot(snapshot, compressors, sideCompressors, engine);
+    
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    auto process = [&]()
+    {
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        for( size_t start = 0; start < static_cast<size_t>(blockSize); start += SimpleMBComp::TILE_SIZE )
+            engine.process(block.getSubBlock(start, juce::jmin(SimpleMBComp::TILE_SIZE, static_cast<size_t>(blockSize) - start)), {});
+    };
+    
+    juce::Random random(0x5eed);
+    juce::AudioBuffer<float> noise(1, blockSize);
+    auto maxDifference = 0.f;
+    for( auto processed = 0.0; processed < sampleRate; processed += blockSize )
+    {
+        fillWithNoise(noise, random);
+        for( int ch = 0; ch < numChannels; ++ch )
+            buffer.copyFrom(ch, 0, noise, 0, 0, blockSize);
+        
+        process();
+        
+        for( int ch = 1; ch < numChannels; ++ch )
+            for( int i = 0; i < blockSize; ++i )
+                maxDifference = juce::jmax(maxDifference, std::abs(buffer.getSample(ch, i) - buffer.getSample(0, i)));
+    }
+    
+    const auto passed = maxDifference == 0.f;
+    
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto ns = measureNsPerSample(process, samplesPerRun);
+    
+    std::cout << "layout"
+              << " name=" << layoutName
+              << " bands=" << NumBands
+              << " channels=" << numChannels
+              << " block=" << blockSize
+              << " rate=" << sampleRate
+              << " ns_per_channel_sample=" << ns
+              << " ns_per_frame=" << ns * numChannels
+              << " channel_difference=" << maxDifference
+              << (passed ? " ok" : " FAILED")
+              << std::endl;
+    
+    return passed;
+}
+
+bool runLayoutBenchmark()
+{
+    auto passed = true;
+    passed &= runLayoutCase("mono", juce::AudioChannelSet::mono().size());
+    passed &= runLayoutCase("stereo", juce::AudioChannelSet::stereo().size());
+    passed &= runLayoutCase("5.1", juce::AudioChannelSet::create5point1().size());
+    passed &= runLayoutCase("7.1.4", juce::AudioChannelSet::create7point1point4().size());
+    passed &= runLayoutCase("ambisonic_3rd_order", juce::AudioChannelSet::ambisonic(3).size());
+    
+    return passed;
+}
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+    
+    LinearPhaseBenchmark.cpp
+    Created: 16 Oct 2026 10:31:06pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/LinearPhaseCrossovers.h"
+
+namespace Benchmarks
+{
+/*
+ the linear-phase split against the Linkwitz-Riley one at host block sizes down to 32.
+ the partitioned convolution should cost about the same per sample at every block size.
+ fails if the bands don't sum back to the delayed input.
+ */
+template<size_t NBands>
+bool runLinearPhaseCase(int numChannels, int blockSize, double sampleRate)
+{
+    const std::array<float, Params::MAX_CROSSOVERS> frequencies { 400.f, 2000.f, 5000.f, 8000.f, 11000.f, 14000.f, 17000.f };
+    const auto spec = juce::dsp::ProcessSpec { sampleRate,
+                                               static_cast<juce::uint32>(blockSize),
+                                               static_cast<juce::uint32>(numChannels) };
+    
+    SimpleMBComp::LinkwitzRileyFilterBank<float, NBands> bank;
+    bank.prepare(spec);
+    for( size_t x = 0; x < NBands - 1; ++x )
+        bank.setCutoffFrequency(x, frequencies[x]);
+    
+    SimpleMBComp::LinearPhaseCrossovers linearPhase;
+    linearPhase.setCrossovers(frequencies, NBands);
+    linearPhase.prepare(spec);
+    
+    //a few partitions' worth of blocks per run, so every run does the same number of FFTs
+    const auto blocksPerRun = static_cast<int>(SimpleMBComp::LinearPhaseCrossovers::PARTITION_SIZE) * 8 / blockSize;
+    const auto latency = linearPhase.getLatencyInSamples();
+    
+    juce::AudioBuffer<float> input(numChannels, blockSize);
+    std::array<juce::AudioBuffer<float>, NBands> bandBuffers;
+    std::array<juce::dsp::AudioBlock<float>, NBands> bands;
+    for( size_t b = 0; b < NBands; ++b )
+    {
+        bandBuffers[b].setSize(numChannels, blockSize);
+        bands[b] = juce::dsp::AudioBlock<float>(bandBuffers[b]);
+    }
+    
+    const auto inputBlock = juce::dsp::AudioBlock<const float>(input);
+    
+    //every input sample is kept until it comes out of the bands 'latency' samples later
+    juce::Random random(0x5eed);
+    juce::AudioBuffer<float> history(numChannels, latency + blockSize);
+    history.clear();
+    
+    auto maxError = 0.f;
+    const auto numCheckBlocks = static_cast<int>(sampleRate) / blockSize + 1;
+    for( int i = 0; i < numCheckBlocks; ++i )
+    {
+        fillWithNoise(input, random);
+        linearPhase.process(inputBlock, bands.data(), NBands);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            auto* past = history.getWritePointer(ch);
+            std::copy_n(input.getReadPointer(ch), blockSize, past + latency);
+            
+            for( int s = 0; s < blockSize; ++s )
+            {
+                auto sum = 0.f;
+                for( auto& band : bandBuffers )
+                    sum += band.getSample(ch, s);
+                
+                maxError = juce::jmax(maxError, std::abs(sum - past[s]));
+            }
+            
+            std::copy(past + blockSize, past + latency + blockSize, past);
+        }
+    }
+    
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels * blocksPerRun);
+    auto bankNs = measureNsPerSample([&]()
+    {
+        for( int i = 0; i < blocksPerRun; ++i )
+            bank.process(inputBlock, bands);
+    }, samplesPerRun);
+    auto linearPhaseNs = measureNsPerSample([&]()
+    {
+        for( int i = 0; i < blocksPerRun; ++i )
+            linearPhase.process(inputBlock, bands.data(), NBands);
+    }, samplesPerRun);
+    
+    static constexpr float tolerance = 1.0e-4f;
+    const auto passed = maxError <= tolerance;
+    
+    std::cout << "linear_phase"
+              << " bands=" << NBands
+              << " channels=" << numChannels
+              << " block=" << blockSize
+              << " rate=" << sampleRate
+              << " latency=" << latency
+              << " linkwitz_riley_ns_per_sample=" << bankNs
+              << " linear_phase_ns_per_sample=" << linearPhaseNs
+              << " cost=" << linearPhaseNs / bankNs
+              << " max_error=" << maxError
+              << (passed ? " ok" : " FAILED")
+              << std::endl;
+    
+    return passed;
+}
+
+bool runLinearPhaseBenchmark()
+{
+    auto passed = true;
+    for( auto blockSize : { 32, 64, 512 } )
+    {
+        passed &= runLinearPhaseCase<3>(2, blockSize, 48000.0);
+        passed &= runLinearPhaseCase<8>(2, blockSize, 48000.0);
+    }
+    
+    return passed;
+}
+}
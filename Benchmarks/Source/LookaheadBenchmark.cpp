@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+    
+    LookaheadBenchmark.cpp
+    Created: 19 Oct 2026 9:14:27am
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+namespace Benchmarks
+{
+/*
+ one band compressing a sine with lookahead at 4x while its attack keeps crossing the 20 ms
+ below which it compresses oversampled, so it switches between the host and the oversampled rate.
+ the lookahead replays what it delayed before the switch, which has to be the same signal either way:
+ no step in the output may be much larger than the largest step of the sine itself.
+ the band is then muted and un-muted again, which has to fade it back in over what the lookahead
+ kept delaying while it was muted, not over silence.
+ */
+bool runLookaheadBenchmark()
+{
+    const auto sampleRate = 48000.0;
+    const auto numChannels = 2;
+    const auto lookaheadSamples = static_cast<size_t>(sampleRate * 0.005); //5 ms
+    const auto order = size_t(2); //4x
+    const auto frequency = 200.0;
+    const auto amplitude = 0.5f;
+    
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+    
+    BandParams params;
+    params.threshold = -12.f;
+    params.ratio = 2; //2:1, so the band stays loud enough for a replayed step to stand out
+    params.release = 100.f;
+    
+    CompressorBand band;
+    params.attachTo(band);
+    band.prepare<float>(tileSpec);
+    
+    SimpleMBComp::SharedDelayLine<float> lookaheadDelay;
+    lookaheadDelay.prepare(static_cast<size_t>(numChannels), lookaheadSamples);
+    band.setDelayLine(lookaheadDelay, 0);
+    band.setLookaheadSamples(lookaheadSamples);
+    band.setOversamplingOrder(order);
+    band.updateCompressorSettings(band.readParameters());
+    
+    juce::AudioBuffer<float> tile(numChannels, static_cast<int>(SimpleMBComp::TILE_SIZE));
+    auto phase = 0.0;
+    const auto increment = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    
+    auto processTile = [&]()
+    {
+        for( int i = 0; i < tile.getNumSamples(); ++i )
+        {
+            auto sample = amplitude * static_cast<float>(std::sin(phase));
+            phase = std::fmod(phase + increment, juce::MathConstants<double>::twoPi);
+            for( int ch = 0; ch < numChannels; ++ch )
+                tile.setSample(ch, i, sample);
+        }
+        
+        band.process(juce::dsp::AudioBlock<float>(tile));
+    };
+    
+    //every 100 ms the attack crosses over to the other side of 20 ms
+    const auto tilesPerSwitch = static_cast<int>(sampleRate * 0.1) / static_cast<int>(SimpleMBComp::TILE_SIZE);
+    auto numSwitches = 0;
+    auto maxStep = 0.f;
+    std::array<float, 2> previous {};
+    
+    //a silent band isn't summed, so what it leaves in the tile counts as silence
+    auto processAndMeasureTile = [&]()
+    {
+        auto isSummed = ! band.isSilent();
+        processTile();
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            for( int i = 0; i < tile.getNumSamples(); ++i )
+            {
+                auto sample = isSummed ? tile.getSample(ch, i) : 0.f;
+                maxStep = juce::jmax(maxStep, std::abs(sample - previous[static_cast<size_t>(ch)]));
+                previous[static_cast<size_t>(ch)] = sample;
+            }
+        }
+    };
+    
+    for( int t = 0; t < tilesPerSwitch * 40; ++t )
+    {
+        if( t % tilesPerSwitch == 0 )
+        {
+            params.attack = (t / tilesPerSwitch) % 2 == 0 ? 25.f : 15.f;
+            band.updateCompressorSettings(band.readParameters());
+            ++numSwitches;
+        }
+        
+        processAndMeasureTile();
+    }
+    
+    //200 ms muted, then 200 ms un-muted
+    for( auto audible : { false, true } )
+    {
+        band.setAudible(audible);
+        for( int t = 0; t < tilesPerSwitch * 2; ++t )
+            processAndMeasureTile();
+    }
+    
+    //the gain stays at or below unity and moves slowly, so the compressed sine never steps much further than the input does
+    const auto sineStep = amplitude * static_cast<float>(increment);
+    const auto passed = maxStep <= 1.5f * sineStep;
+    
+    auto nsPerSample = measureNsPerSample(processTile, SimpleMBComp::TILE_SIZE * static_cast<size_t>(numChannels));
+    
+    std::cout << "lookahead"
+              << " rate=" << sampleRate
+              << " oversampling=" << (1 << order)
+              << " lookahead_samples=" << lookaheadSamples
+              << " switches=" << numSwitches
+              << " ns_per_sample=" << nsPerSample
+              << " sine_step=" << sineStep
+              << " max_step=" << maxStep
+              << (passed ? " ok" : " FAILED")
+              << std::endl;
+    
+    return passed;
+}
+}
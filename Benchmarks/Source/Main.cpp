@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+    
+    Main.cpp
+    Created: 16 Oct 2026 3:02:45pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Benchmarks.h"
+#include "RegressionGate.h"
+#include "../../Source/DSP/Kernels.h"
+
+namespace
+{
+struct Benchmark
+{
+    const char* name;
+    bool (*run)();
+};
+
+const std::array<Benchmark, 17> benchmarks
+{{
+    { "block_sizes", Benchmarks::runBlockSizeBenchmark },
+    { "crossover", Benchmarks::runCrossoverBenchmark },
+    { "editor", Benchmarks::runEditorBenchmark },
+    { "idle", Benchmarks::runIdleBenchmark },
+    { "isa", Benchmarks::runIsaBenchmark },
+    { "linear_phase", Benchmarks::runLinearPhaseBenchmark },
+    { "lookahead", Benchmarks::runLookaheadBenchmark },
+    { "compressor", Benchmarks::runCompressorBenchmark },
+    { "layout", Benchmarks::runLayoutBenchmark },
+    { "mid_side", Benchmarks::runMidSideBenchmark },
+    { "parallel_bands", Benchmarks::runParallelBandsBenchmark },
+    { "precision", Benchmarks::runPrecisionBenchmark },
+    { "process_block", Benchmarks::runProcessBlockBenchmark },
+    { "realtime", Benchmarks::runRealtimeBenchmark },
+    { "sidechain", Benchmarks::runSidechainBenchmark },
+    { "stages", Benchmarks::runStageBenchmark },
+    { "update_state", Benchmarks::runUpdateStateBenchmark },
+}};
+
+//what the regression gate measures when no benchmarks are named
+const juce::StringArray gatedBenchmarks { "process_block", "stages", "editor" };
+
+void printUsage()
+{
+    std::cout << "usage: SimpleMBCompBenchmarks [--gate <directory>] [--update] [--threshold <percent>] [--tolerance <value>] [--isa <variant>] [benchmark...]" << std::endl
+              << "  --gate       compares the timings against <directory>/baseline.json" << std::endl
+              << "               and the output against the renders in <directory>/golden" << std::endl
+              << "  --update     writes the timings and renders as the new baseline instead of comparing" << std::endl
+              << "  --threshold  how much slower than the baseline a case may get, 10 by default" << std::endl
+              << "  --tolerance  the largest sample difference from a golden render, 0.0001 by default" << std::endl
+              << "  --isa        runs every kernel as generic, avx2 or avx512 instead of the variant picked by CPUID" << std::endl
+              << "benchmarks:";
+    for( const auto& b : benchmarks )
+        std::cout << " " << b.name;
+    std::cout << std::endl;
+}
+}
+
+/*
+ runs the benchmarks named on the command line, or all of them.
+ every case prints one line: the case name followed by key=value pairs.
+ with --gate the run fails if anything got slower than the baseline allows or sounds different.
+ */
+int main (int argc, char* argv[])
+{
+    using SimpleMBComp::Kernels::Isa;
+    
+    //the processor's parameters and value tree expect a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ScopedNoDenormals noDenormals;
+    
+    Benchmarks::GateSettings gate;
+    auto isGating = false;
+    juce::StringArray selected;
+    
+    for( int i = 1; i < argc; ++i )
+    {
+        auto arg = juce::String(argv[i]);
+        auto hasValue = i + 1 < argc;
+        
+        if( arg == "--gate" && hasValue )
+        {
+            isGating = true;
+            gate.directory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        }
+        else if( arg == "--update" )
+            gate.update = true;
+        else if( arg == "--threshold" && hasValue )
+            gate.threshold = juce::String(argv[++i]).getDoubleValue() / 100.0;
+        else if( arg == "--tolerance" && hasValue )
+            gate.tolerance = juce::String(argv[++i]).getFloatValue();
+        else if( arg == "--isa" && hasValue )
+        {
+            auto name = juce::String(argv[++i]);
+            auto isForced = false;
+            for( auto isa : { Isa::Generic, Isa::AVX2, Isa::AVX512 } )
+            {
+                if( name.equalsIgnoreCase(SimpleMBComp::Kernels::getName(isa)) )
+                    isForced = SimpleMBComp::Kernels::setActiveIsa(isa);
+            }
+            
+            if( ! isForced )
+            {
+                std::cout << name << " is not a variant this CPU can run" << std::endl;
+                return 1;
+            }
+        }
+        else if( arg.startsWith("--") )
+        {
+            printUsage();
+            return 1;
+        }
+        else
+        {
+            auto isKnown = std::any_of(benchmarks.begin(), benchmarks.end(), [&arg](const auto& b) { return arg == b.name; });
+            if( ! isKnown )
+            {
+                printUsage();
+                return 1;
+            }
+            
+            selected.add(arg);
+        }
+    }
+    
+    if( gate.update && ! isGating )
+    {
+        printUsage();
+        return 1;
+    }
+    
+    if( isGating && selected.isEmpty() )
+        selected = gatedBenchmarks;
+    
+    auto passed = true;
+    for( const auto& b : benchmarks )
+    {
+        if( selected.isEmpty() || selected.contains(b.name) )
+            passed &= b.run();
+    }
+    
+    if( isGating )
+        passed &= Benchmarks::runRegressionGate(gate);
+    
+    return passed ? 0 : 1;
+}
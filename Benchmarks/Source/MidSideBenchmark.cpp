@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+    
+    MidSideBenchmark.cpp
+    Created: 17 Oct 2026 12:31:08am
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+namespace Benchmarks
+{
+/*
+ the band path in left/right and in mid/side mode.
+ the encode happens while the first crossover reads the input and the decode while the bands are summed,
+ so mid/side should cost no more than left/right apart from the second compressor per band.
+ with nothing being compressed both modes have to put out the same thing.
+ */
+bool runMidSideBenchmark()
+{
+    static constexpr size_t NumBands = 3;
+    const auto sampleRate = 48000.0;
+    const auto numChannels = 2;
+    const auto blockSize = 512;
+    
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+    
+    struct Path
+    {
+        std::array<BandParams, NumBands> params, sideParams;
+        SimpleMBComp::CompressorBands compressors, sideCompressors;
+        SimpleMBComp::BandBuffers buffers;
+        SimpleMBComp::LinearPhaseCrossovers linearPhase;
+        SimpleMBComp::MultiBandEngine<NumBands> engine { compressors, sideCompressors, buffers, linearPhase };
+        SimpleMBComp::ProcessingSnapshot snapshot;
+        
+        void prepare(const juce::dsp::ProcessSpec& spec, float thresholdDb, bool midSide)
+        {
+            for( size_t i = 0; i < NumBands; ++i )
+            {
+                for( auto* p : { &params[i], &sideParams[i] } )
+                    p->threshold = thresholdDb;
+                
+                params[i].attachTo(compressors[i]);
+                sideParams[i].attachTo(sideCompressors[i]);
+                
+                for( auto* comp : { &compressors[i], &sideCompressors[i] } )
+                    comp->prepare<float>(spec);
+                
+                buffers.floats[i].setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+            }
+            
+            engine.prepare(spec);
+            snapshot = makeSnapshot(NumBands, { 400.f, 2000.f }, midSide);
+            updateFromSnapshot(snapshot, compressors, sideCompressors, engine);
+        }
+        
+        void process(juce::AudioBuffer<float>& buffer)
+        {
+            auto block = juce::dsp::AudioBlock<float>(buffer);
+            const auto numSamples = block.getNumSamples();
+            for( size_t start = 0; start < numSamples; start += SimpleMBComp::TILE_SIZE )
+            {
+                auto length = juce::jmin(SimpleMBComp::TILE_SIZE, numSamples - start);
+                engine.process(block.getSubBlock(start, length), {});
+            }
+        }
+    };
+    
+    //noise in [-1, 1) never reaches the highest threshold
+    Path leftRight, midSide;
+    leftRight.prepare(tileSpec, SimpleMBComp::MAX_DB, false);
+    midSide.prepare(tileSpec, SimpleMBComp::MAX_DB, true);
+    
+    juce::AudioBuffer<float> input(numChannels, blockSize), leftRightBuffer(numChannels, blockSize), midSideBuffer(numChannels, blockSize);
+    
+    juce::Random random(0x5eed);
+    auto maxDifference = 0.f;
+    for( auto processed = 0.0; processed < sampleRate; processed += blockSize )
+    {
+        fillWithNoise(input, random);
+        leftRightBuffer.makeCopyOf(input, true);
+        midSideBuffer.makeCopyOf(input, true);
+        
+        leftRight.process(leftRightBuffer);
+        midSide.process(midSideBuffer);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            for( int i = 0; i < blockSize; ++i )
+                maxDifference = juce::jmax(maxDifference, std::abs(midSideBuffer.getSample(ch, i) - leftRightBuffer.getSample(ch, i)));
+    }
+    
+    static constexpr float tolerance = 1.0e-5f;
+    const auto passed = maxDifference <= tolerance;
+    
+    //the timings compress, so every compressor does its full amount of work
+    Path leftRightCompressing, midSideCompressing;
+    leftRightCompressing.prepare(tileSpec, -18.f, false);
+    midSideCompressing.prepare(tileSpec, -18.f, true);
+    
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto leftRightNs = measureNsPerSample([&]() { leftRightCompressing.process(leftRightBuffer); }, samplesPerRun);
+    auto midSideNs = measureNsPerSample([&]() { midSideCompressing.process(midSideBuffer); }, samplesPerRun);
+    
+    std::cout << "midside"
+              << " bands=" << NumBands
+              << " channels=" << numChannels
+              << " block=" << blockSize
+              << " rate=" << sampleRate
+              << " lr_ns_per_sample=" << leftRightNs
+              << " ms_ns_per_sample=" << midSideNs
+              << " max_difference=" << maxDifference
+              << (passed ? " ok" : " FAILED")
+              << std::endl;
+    
+    return passed;
+}
+}
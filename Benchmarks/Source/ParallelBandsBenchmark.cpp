@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ParallelBandsBenchmark.cpp
+    Created: 17 Oct 2026 9:58:03pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+
+namespace Benchmarks
+{
+/*
+ renders a second of noise through a processor with its bands compressed serially or in parallel,
+ and times one more block.
+ */
+std::vector<float> renderBands(bool parallel, size_t numBands, int numChannels, int blockSize, double& nsPerSample)
+{
+    const auto sampleRate = 48000.0;
+
+    ProcessorOptions options;
+    options.sampleRate = sampleRate;
+    options.blockSize = blockSize;
+    options.numChannels = numChannels;
+    options.numBands = numBands;
+    auto prepared = makePreparedProcessor(options, [parallel](auto& processor) { processor.setParallelBandsEnabled(parallel); });
+    auto& processor = *prepared;
+
+    juce::AudioBuffer<float> noise(numChannels, blockSize), buffer(numChannels, blockSize);
+    juce::Random random(0x5eed);
+    juce::MidiBuffer midi;
+
+    std::vector<float> rendered;
+    for( auto processed = 0.0; processed < sampleRate; processed += blockSize )
+    {
+        fillWithNoise(buffer, random);
+        processor.processBlock(buffer, midi);
+        for( int ch = 0; ch < numChannels; ++ch )
+            rendered.insert(rendered.end(), buffer.getReadPointer(ch), buffer.getReadPointer(ch) + blockSize);
+    }
+
+    fillWithNoise(noise, random);
+    nsPerSample = measureNsPerSample([&]()
+    {
+        buffer.makeCopyOf(noise, true);
+        processor.processBlock(buffer, midi);
+    }, static_cast<size_t>(blockSize * numChannels), getNumRuns(blockSize));
+
+    processor.releaseResources();
+    return rendered;
+}
+
+/*
+ how processBlock scales when the bands of long blocks are compressed on the shared workers.
+ every band compresses exactly the tiles it would one tile at a time,
+ so anything but identical output from the two fails.
+ */
+bool runParallelBandsBenchmark()
+{
+    //held for the whole run, so the workers aren't started again for every case
+    juce::SharedResourcePointer<SimpleMBComp::BandWorkerPool> workers;
+    auto passed = true;
+
+    for( size_t numBands : { size_t(3), Params::MAX_BANDS } )
+    {
+        for( auto numChannels : { 2, 8 } )
+        {
+            for( auto blockSize : { 2048, 4096, 8192 } )
+            {
+                auto serialNs = 0.0, parallelNs = 0.0;
+                auto serial = renderBands(false, numBands, numChannels, blockSize, serialNs);
+                auto parallel = renderBands(true, numBands, numChannels, blockSize, parallelNs);
+                auto identical = serial == parallel;
+                passed &= identical;
+
+                std::cout << "parallel_bands"
+                          << " bands=" << numBands
+                          << " channels=" << numChannels
+                          << " block=" << blockSize
+                          << " workers=" << workers->getNumWorkers()
+                          << " serial_ns_per_sample=" << serialNs
+                          << " parallel_ns_per_sample=" << parallelNs
+                          << " speedup=" << serialNs / parallelNs
+                          << (identical ? " ok" : " FAILED")
+                          << std::endl;
+            }
+        }
+    }
+
+    return passed;
+}
+}
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+    
+    PrecisionBenchmark.cpp
+    Created: 16 Oct 2026 9:05:37pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+namespace Benchmarks
+{
+/*
+ one complete signal path (split, compress, sum) in a single precision
+ */
+template<typename SampleType, size_t NumBands>
+struct PrecisionPath
+{
+    SimpleMBComp::CompressorBands compressors, sideCompressors;
+    SimpleMBComp::BandBuffers buffers;
+    SimpleMBComp::LinearPhaseCrossovers linearPhase;
+    SimpleMBComp::MultiBandEngine<NumBands> engine { compressors, sideCompressors, buffers, linearPhase };
+    SimpleMBComp::ProcessingSnapshot snapshot;
+    
+    void prepare(std::array<BandParams, NumBands>& params,
+                 const juce::dsp::ProcessSpec& tileSpec,
+                 const SimpleMBComp::CrossoverFrequencies& frequencies,
+                 size_t oversamplingOrder)
+    {
+        for( size_t i = 0; i < NumBands; ++i )
+        {
+            params[i].attachTo(compressors[i]);
+            compressors[i].prepare<SampleType>(tileSpec);
+            compressors[i].setOversamplingOrder(oversamplingOrder);
+            
+            buffers.get<SampleType>()[i].setSize(static_cast<int>(tileSpec.numChannels),
+                                                 static_cast<int>(tileSpec.maximumBlockSize));
+        }
+        
+        engine.prepare(tileSpec);
+        snapshot = makeSnapshot(NumBands, frequencies);
+        updateFromSnapshot(snapshot, compressors, sideCompressors, engine);
+    }
+    
+    void process(juce::AudioBuffer<SampleType>& buffer)
+    {
+        auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+        const auto numSamples = block.getNumSamples();
+        for( size_t start = 0; start < numSamples; start += SimpleMBComp::TILE_SIZE )
+            engine.process(block.getSubBlock(start, juce::jmin(SimpleMBComp::TILE_SIZE, numSamples - start)), {});
+    }
+};
+
+/*
+ the whole band path in float and in double, so a session can pick its precision knowing the cost.
+ fails if the two drift further apart than float rounding explains.
+ */
+bool runPrecisionBenchmark()
+{
+    static constexpr size_t NumBands = 3;
+    const auto sampleRate = 48000.0;
+    const auto numChannels = 2;
+    const auto blockSize = 512;
+    auto passed = true;
+    
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+    const SimpleMBComp::CrossoverFrequencies frequencies { 400.f, 2000.f };
+    
+    for( size_t order : { size_t(0), size_t(2) } )
+    {
+        std::array<BandParams, NumBands> params;
+        for( auto& p : params )
+        {
+            p.threshold = -18.f;
+            p.attack = 10.f; //fast enough to compress oversampled
+        }
+        
+        PrecisionPath<float, NumBands> floatPath;
+        PrecisionPath<double, NumBands> doublePath;
+        floatPath.prepare(params, tileSpec, frequencies, order);
+        doublePath.prepare(params, tileSpec, frequencies, order);
+        
+        juce::AudioBuffer<float> floatBuffer(numChannels, blockSize);
+        juce::AudioBuffer<double> doubleBuffer(numChannels, blockSize);
+        
+        //a second of the same noise through both
+        juce::Random random(0x5eed);
+        auto maxError = 0.0;
+        for( auto processed = 0.0; processed < sampleRate; processed += blockSize )
+        {
+            fillWithNoise(floatBuffer, random);
+            for( int ch = 0; ch < numChannels; ++ch )
+                for( int i = 0; i < blockSize; ++i )
+                    doubleBuffer.setSample(ch, i, static_cast<double>(floatBuffer.getSample(ch, i)));
+            
+            floatPath.process(floatBuffer);
+            doublePath.process(doubleBuffer);
+            
+            for( int ch = 0; ch < numChannels; ++ch )
+                for( int i = 0; i < blockSize; ++i )
+                    maxError = juce::jmax(maxError, std::abs(doubleBuffer.getSample(ch, i) - static_cast<double>(floatBuffer.getSample(ch, i))));
+        }
+        
+        static constexpr double tolerance = 1.0e-4;
+        const auto matched = maxError <= tolerance;
+        passed &= matched;
+        
+        const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+        auto floatNs = measureNsPerSample([&]() { floatPath.process(floatBuffer); }, samplesPerRun);
+        auto doubleNs = measureNsPerSample([&]() { doublePath.process(doubleBuffer); }, samplesPerRun);
+        
+        std::cout << "precision"
+                  << " bands=" << NumBands
+                  << " channels=" << numChannels
+                  << " block=" << blockSize
+                  << " rate=" << sampleRate
+                  << " oversampling=" << (1 << order) << "x"
+                  << " float_ns_per_sample=" << floatNs
+                  << " double_ns_per_sample=" << doubleNs
+                  << " double_cost=" << doubleNs / floatNs
+                  << " max_difference=" << maxError
+                  << (matched ? " ok" : " FAILED")
+                  << std::endl;
+    }
+    
+    return passed;
+}
+}
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    ProcessBlockBenchmark.cpp
+    Created: 17 Oct 2026 3:26:09pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+#include "RegressionGate.h"
+
+namespace Benchmarks
+{
+/*
+ the whole plugin, from input gain to output gain, the way a host calls it.
+ every band compresses, so the compressors do their full amount of work.
+ the only check is that nothing but finite samples come out.
+ */
+bool runProcessBlockCase(int numChannels, int blockSize, double sampleRate, BandState state)
+{
+    //3 bands, the default
+    ProcessorOptions options;
+    options.sampleRate = sampleRate;
+    options.blockSize = blockSize;
+    options.numChannels = numChannels;
+    
+    //solo and mute only touch the low band, bypass bypasses every band
+    auto prepared = makePreparedProcessor(options, [&options, state](auto& processor)
+    {
+        auto& apvts = processor.apvts;
+        const auto& lowBand = Params::GetBandParams()[0];
+        if( state == BandState::Solo )
+            setParameter(apvts, lowBand.at(Params::BandNames::Solo), 1.f);
+        else if( state == BandState::Mute )
+            setParameter(apvts, lowBand.at(Params::BandNames::Mute), 1.f);
+        else if( state == BandState::Bypass )
+        {
+            for( size_t band = 0; band < options.numBands; ++band )
+                setParameter(apvts, Params::GetBandParams()[band].at(Params::BandNames::Bypassed), 1.f);
+        }
+    });
+    
+    if( prepared == nullptr )
+    {
+        std::cout << "process_block channels=" << numChannels << " FAILED no layout" << std::endl;
+        return false;
+    }
+    
+    auto& processor = *prepared;
+
+    juce::AudioBuffer<float> noise(numChannels, blockSize), buffer(numChannels, blockSize);
+    juce::Random random(0x5eed);
+    fillWithNoise(noise, random);
+    juce::MidiBuffer midi;
+
+    auto process = [&]()
+    {
+        buffer.makeCopyOf(noise, true);
+        processor.processBlock(buffer, midi);
+    };
+
+    //long enough for every fade to finish and every envelope to settle
+    auto isFinite = true;
+    for( auto processed = 0.0; processed < sampleRate * 0.5; processed += blockSize )
+    {
+        process();
+        for( int ch = 0; ch < numChannels; ++ch )
+            for( int i = 0; i < blockSize; ++i )
+                isFinite &= std::isfinite(buffer.getSample(ch, i));
+    }
+
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto ns = measureNsPerSample(process, samplesPerRun, getNumRuns(blockSize));
+
+    processor.releaseResources();
+
+    juce::String name;
+    name << "process_block"
+         << " bands=3"
+         << " channels=" << numChannels
+         << " block=" << blockSize
+         << " rate=" << sampleRate
+         << " state=" << getName(state);
+    
+    record(name, ns);
+    
+    std::cout << name
+              << " ns_per_sample=" << ns
+              << (isFinite ? " ok" : " FAILED")
+              << std::endl;
+
+    return isFinite;
+}
+
+bool runProcessBlockBenchmark()
+{
+    auto passed = true;
+    for( auto sampleRate : SWEEP_SAMPLE_RATES )
+        for( auto blockSize : SWEEP_BLOCK_SIZES )
+            passed &= runProcessBlockCase(2, blockSize, sampleRate, BandState::Normal);
+
+    for( auto numChannels : SWEEP_CHANNELS )
+        passed &= runProcessBlockCase(numChannels, 512, 48000.0, BandState::Normal);
+
+    for( auto state : { BandState::Solo, BandState::Mute, BandState::Bypass } )
+        passed &= runProcessBlockCase(2, 512, 48000.0, state);
+
+    return passed;
+}
+}
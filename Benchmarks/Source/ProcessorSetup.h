@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+    
+    ProcessorSetup.h
+    Created: 17 Oct 2026 5:12:37pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../../Source/BusLayouts.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace Benchmarks
+{
+/*
+ sets a parameter the way the host would, 'value' in the parameter's own range.
+ a choice parameter takes the index of the choice.
+ */
+inline void setParameter(juce::AudioProcessorValueTreeState& apvts, const juce::String& name, float value)
+{
+    auto* param = apvts.getParameter(name);
+    jassert(param != nullptr);
+    param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+using SimpleMBComp::setMainBusWidth;
+
+/*
+ the setup every benchmark driving the whole plugin starts from
+ */
+struct ProcessorOptions
+{
+    double sampleRate { 48000.0 };
+    int blockSize { 512 };
+    
+    //the main bus this wide, without a sidechain.  0 keeps the default layout
+    int numChannels { 2 };
+    
+    //the bands in use all compress at 'thresholdDb'
+    size_t numBands { 3 };
+    float thresholdDb { -18.f };
+    
+    bool midSide { false };
+    bool linearPhase { false };
+    bool doublePrecision { false };
+};
+
+/*
+ a processor set up from 'options' and prepared to play, nullptr if the layout isn't supported.
+ setup(processor) runs just before prepareToPlay(), for anything else that has to be set by then.
+ */
+template<typename Setup>
+std::unique_ptr<SimpleMBCompAudioProcessor> makePreparedProcessor(const ProcessorOptions& options, Setup&& setup)
+{
+    auto processor = std::make_unique<SimpleMBCompAudioProcessor>();
+    if( options.numChannels > 0 && ! setMainBusWidth(*processor, options.numChannels) )
+        return nullptr;
+    
+    auto& apvts = processor->apvts;
+    using namespace Params;
+    setParameter(apvts, GetParams().at(Names::Number_Of_Bands), static_cast<float>(options.numBands - MIN_BANDS));
+    for( size_t band = 0; band < options.numBands; ++band )
+        setParameter(apvts, GetBandParams()[band].at(BandNames::Threshold), options.thresholdDb);
+    
+    if( options.midSide )
+        setParameter(apvts, GetParams().at(Names::Stereo_Mode), static_cast<float>(StereoModes::Mid_Side));
+    if( options.linearPhase )
+        setParameter(apvts, GetParams().at(Names::Crossover_Mode), static_cast<float>(CrossoverModes::Linear_Phase));
+    
+    setup(*processor);
+    
+    if( options.doublePrecision )
+        processor->setProcessingPrecision(juce::AudioProcessor::doublePrecision);
+    
+    processor->setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+    processor->prepareToPlay(options.sampleRate, options.blockSize);
+    
+    return processor;
+}
+
+inline std::unique_ptr<SimpleMBCompAudioProcessor> makePreparedProcessor(const ProcessorOptions& options)
+{
+    return makePreparedProcessor(options, [](SimpleMBCompAudioProcessor&) { });
+}
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+    
+    RealtimeBenchmark.cpp
+    Created: 19 Oct 2026 11:02:19am
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+
+namespace Benchmarks
+{
+/*
+ drives one processor the way a busy session does: every block comes in at a different size,
+ and in between the host moves parameters around, all of them, the ones that rebuild the
+ signal path (band count, crossover mode, stereo mode, oversampling, lookahead) included.
+ returns the number of realtime violations recorded while it ran.
+ */
+template<typename SampleType>
+size_t driveWithAutomation(int preparedBlockSize, size_t numBlocks, double& nsPerSample)
+{
+    ProcessorOptions options;
+    options.blockSize = preparedBlockSize;
+    options.doublePrecision = std::is_same_v<SampleType, double>;
+    auto prepared = makePreparedProcessor(options, [](auto& processor)
+    {
+        //the sidechain is enabled so the keyed path gets automated too
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(1) = juce::AudioChannelSet::stereo();
+        processor.setBusesLayout(layout);
+    });
+    auto& processor = *prepared;
+    
+    const auto numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+    const auto maxBlockSize = preparedBlockSize * 4;
+    juce::AudioBuffer<SampleType> buffer(numChannels, maxBlockSize);
+    juce::MidiBuffer midi;
+    juce::Random random(0x5eed);
+    
+    const auto& parameters = processor.getParameters();
+    
+    SimpleMBComp::RealtimeSafety::clearViolations();
+    
+    auto elapsed = 0.0;
+    auto numSamples = 0;
+    for( size_t i = 0; i < numBlocks; ++i )
+    {
+        //about a quarter of the parameters move before every block, from the host's thread as far as the processor can tell
+        for( auto* parameter : parameters )
+        {
+            if( random.nextInt(4) == 0 )
+                parameter->setValueNotifyingHost(random.nextFloat());
+        }
+        
+        auto blockSize = random.nextInt(maxBlockSize + 1);
+        buffer.setSize(numChannels, blockSize, false, false, true);
+        fillWithNoise(buffer, random);
+        
+        auto ticks = juce::Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midi);
+        elapsed += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticks);
+        numSamples += blockSize;
+    }
+    
+    auto numViolations = SimpleMBComp::RealtimeSafety::getNumViolations();
+    
+    processor.releaseResources();
+    
+    nsPerSample = elapsed * 1.0e9 / static_cast<double>(juce::jmax(1, numSamples * numChannels));
+    return numViolations;
+}
+
+/*
+ nothing the host can throw at the processor while it is playing may make the audio thread
+ allocate, lock or block.  with SIMPLEMBCOMP_REALTIME_CHECKS (the RealtimeCheck configuration)
+ any of that fails it, without it this only shows the cost of processing under heavy automation.
+ */
+bool runRealtimeBenchmark()
+{
+    static constexpr size_t NumBlocks = 2000;
+    auto passed = true;
+    
+    //the second size uses the parallel band path for every block of PARALLEL_CHUNK_SIZE or more
+    for( auto preparedBlockSize : { 512, static_cast<int>(SimpleMBComp::PARALLEL_CHUNK_SIZE) } )
+    {
+        for( auto isDouble : { false, true } )
+        {
+            auto nsPerSample = 0.0;
+            auto numViolations = isDouble ? driveWithAutomation<double>(preparedBlockSize, NumBlocks, nsPerSample)
+                                          : driveWithAutomation<float>(preparedBlockSize, NumBlocks, nsPerSample);
+            
+            auto ok = numViolations == 0;
+            passed &= ok;
+            
+            std::cout << "realtime"
+                      << " prepared=" << preparedBlockSize
+                      << " precision=" << (isDouble ? "double" : "float")
+                      << " blocks=" << NumBlocks
+                      << " ns_per_sample=" << nsPerSample
+                      << " realtime_violations=" << numViolations
+                      << (SIMPLEMBCOMP_REALTIME_CHECKS ? "" : " (not checked in this configuration)")
+                      << (ok ? " ok" : " FAILED")
+                      << std::endl;
+            
+            if( numViolations > 0 )
+                std::cout << SimpleMBComp::RealtimeSafety::describeViolations() << std::endl;
+        }
+    }
+    
+    return passed;
+}
+}
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+    
+    RegressionGate.cpp
+    Created: 17 Oct 2026 5:12:37pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "RegressionGate.h"
+#include "Benchmarks.h"
+#include "ProcessorSetup.h"
+
+namespace Benchmarks
+{
+namespace
+{
+std::map<juce::String, double>& getMeasurements()
+{
+    static std::map<juce::String, double> measurements;
+    return measurements;
+}
+
+bool compareAgainstBaseline(const GateSettings& settings)
+{
+    auto baselineFile = settings.directory.getChildFile("baseline.json");
+    const auto& measurements = getMeasurements();
+    
+    if( settings.update )
+    {
+        juce::DynamicObject::Ptr baseline = new juce::DynamicObject();
+        for( const auto& [name, value] : measurements )
+            baseline->setProperty(name, value);
+        
+        auto written = baselineFile.replaceWithText(juce::JSON::toString(juce::var(baseline.get())));
+        std::cout << "gate baseline " << baselineFile.getFullPathName() << (written ? " written" : " FAILED can't write") << std::endl;
+        return written;
+    }
+    
+    auto parsed = juce::JSON::parse(baselineFile);
+    auto* baseline = parsed.getDynamicObject();
+    if( baseline == nullptr )
+    {
+        std::cout << "gate baseline " << baselineFile.getFullPathName() << " FAILED can't read" << std::endl;
+        return false;
+    }
+    
+    auto passed = true;
+    for( const auto& [name, value] : measurements )
+    {
+        if( ! baseline->hasProperty(name) )
+        {
+            std::cout << "gate " << name << " current=" << value << " new" << std::endl;
+            continue;
+        }
+        
+        const auto baselineValue = static_cast<double>(baseline->getProperty(name));
+        const auto change = value / baselineValue - 1.0;
+        const auto ok = change <= settings.threshold;
+        passed &= ok;
+        
+        std::cout << "gate " << name
+                  << " baseline=" << baselineValue
+                  << " current=" << value
+                  << " change=" << change * 100.0 << "%"
+                  << (ok ? " ok" : " REGRESSED")
+                  << std::endl;
+    }
+    
+    return passed;
+}
+
+struct GoldenCase
+{
+    const char* name;
+    std::function<void(juce::AudioProcessorValueTreeState&)> setup;
+};
+
+void setThresholds(juce::AudioProcessorValueTreeState& apvts, float thresholdDb)
+{
+    for( const auto& band : Params::GetBandParams() )
+        setParameter(apvts, band.at(Params::BandNames::Threshold), thresholdDb);
+}
+
+const std::vector<GoldenCase>& getGoldenCases()
+{
+    using namespace Params;
+    
+    static const std::vector<GoldenCase> cases
+    {
+        { "default", [](auto& apvts)
+            {
+                setThresholds(apvts, -18.f);
+            }
+        },
+        { "solo_mid_band", [](auto& apvts)
+            {
+                setThresholds(apvts, -18.f);
+                setParameter(apvts, GetBandParams()[1].at(BandNames::Solo), 1.f);
+            }
+        },
+        { "five_bands_linear_phase", [](auto& apvts)
+            {
+                setThresholds(apvts, -24.f);
+                setParameter(apvts, GetParams().at(Names::Number_Of_Bands), 3.f); //2, 3, 4, 5
+                setParameter(apvts, GetParams().at(Names::Crossover_Mode), static_cast<float>(CrossoverModes::Linear_Phase));
+            }
+        },
+        { "mid_side_4x_lookahead", [](auto& apvts)
+            {
+                setThresholds(apvts, -18.f);
+                for( const auto& band : GetSideBandParams() )
+                    setParameter(apvts, band.at(BandNames::Threshold), -30.f);
+                
+                setParameter(apvts, GetParams().at(Names::Stereo_Mode), static_cast<float>(StereoModes::Mid_Side));
+                setParameter(apvts, GetParams().at(Names::Oversampling), 2.f); //1x, 2x, 4x
+                setParameter(apvts, GetParams().at(Names::Lookahead), 5.f);
+            }
+        },
+    };
+    
+    return cases;
+}
+
+/*
+ 2 seconds of stereo noise jumping between quiet and loud every 250 ms, so every band attacks and releases.
+ the blocks aren't a multiple of the tile size, so the last tile of every block is a short one.
+ */
+juce::AudioBuffer<float> renderGoldenCase(const GoldenCase& goldenCase)
+{
+    const auto sampleRate = 48000.0;
+    const auto blockSize = 500;
+    const auto numChannels = 2;
+    const auto numSamples = static_cast<int>(sampleRate) * 2;
+    const auto segmentLength = static_cast<int>(sampleRate) / 4;
+    
+    SimpleMBCompAudioProcessor processor;
+    processor.setNonRealtime(true);
+    setMainBusWidth(processor, numChannels);
+    goldenCase.setup(processor.apvts);
+    
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+    
+    juce::AudioBuffer<float> audio(numChannels, numSamples);
+    juce::Random random(0x5eed);
+    fillWithNoise(audio, random);
+    for( int start = 0, segment = 0; start < numSamples; start += segmentLength, ++segment )
+        audio.applyGain(start, juce::jmin(segmentLength, numSamples - start), segment % 2 == 0 ? 0.03f : 0.7f);
+    
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    juce::MidiBuffer midi;
+    for( int start = 0; start < numSamples; start += blockSize )
+    {
+        const auto length = juce::jmin(blockSize, numSamples - start);
+        block.setSize(numChannels, length, false, false, true);
+        for( int ch = 0; ch < numChannels; ++ch )
+            block.copyFrom(ch, 0, audio, ch, start, length);
+        
+        processor.processBlock(block, midi);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            audio.copyFrom(ch, start, block, ch, 0, length);
+    }
+    
+    processor.releaseResources();
+    return audio;
+}
+
+bool writeGolden(const juce::File& file, const juce::AudioBuffer<float>& audio)
+{
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if( stream->failedToOpen() )
+        return false;
+    
+    //32 bit wav is stored as float, so nothing is lost to quantization
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(),
+                                                                         48000.0,
+                                                                         static_cast<unsigned int>(audio.getNumChannels()),
+                                                                         32,
+                                                                         {},
+                                                                         0));
+    if( writer == nullptr )
+        return false;
+    
+    //the writer owns it now
+    stream.release();
+    return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+}
+
+bool readGolden(const juce::File& file, juce::AudioBuffer<float>& audio)
+{
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+    if( reader == nullptr )
+        return false;
+    
+    audio.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+    return reader->read(&audio, 0, audio.getNumSamples(), 0, true, true);
+}
+
+bool compareAgainstGoldenRenders(const GateSettings& settings)
+{
+    auto goldenDirectory = settings.directory.getChildFile("golden");
+    if( settings.update )
+        goldenDirectory.createDirectory();
+    
+    auto passed = true;
+    for( const auto& goldenCase : getGoldenCases() )
+    {
+        auto file = goldenDirectory.getChildFile(juce::String(goldenCase.name) + ".wav");
+        auto rendered = renderGoldenCase(goldenCase);
+        
+        if( settings.update )
+        {
+            auto written = writeGolden(file, rendered);
+            passed &= written;
+            std::cout << "gate golden=" << goldenCase.name << (written ? " written" : " FAILED can't write") << std::endl;
+            continue;
+        }
+        
+        juce::AudioBuffer<float> golden;
+        if( ! readGolden(file, golden) )
+        {
+            passed = false;
+            std::cout << "gate golden=" << goldenCase.name << " FAILED can't read " << file.getFullPathName() << std::endl;
+            continue;
+        }
+        
+        if( golden.getNumChannels() != rendered.getNumChannels() || golden.getNumSamples() != rendered.getNumSamples() )
+        {
+            passed = false;
+            std::cout << "gate golden=" << goldenCase.name << " FAILED different length or width" << std::endl;
+            continue;
+        }
+        
+        auto maxDifference = 0.f;
+        for( int ch = 0; ch < golden.getNumChannels(); ++ch )
+        {
+            auto* expected = golden.getReadPointer(ch);
+            auto* actual = rendered.getReadPointer(ch);
+            for( int i = 0; i < golden.getNumSamples(); ++i )
+            {
+                //a NaN never compares greater, it counts as the largest difference there is
+                auto difference = std::abs(expected[i] - actual[i]);
+                if( std::isnan(difference) )
+                    difference = std::numeric_limits<float>::infinity();
+                
+                maxDifference = juce::jmax(maxDifference, difference);
+            }
+        }
+        
+        const auto ok = maxDifference <= settings.tolerance;
+        passed &= ok;
+        
+        std::cout << "gate golden=" << goldenCase.name
+                  << " max_difference=" << maxDifference
+                  << (ok ? " ok" : " DIFFERENT")
+                  << std::endl;
+    }
+    
+    return passed;
+}
+}
+
+void record(const juce::String& name, double value)
+{
+    getMeasurements()[name] = value;
+}
+
+bool runRegressionGate(const GateSettings& settings)
+{
+    if( settings.update )
+        settings.directory.createDirectory();
+    
+    auto passed = compareAgainstBaseline(settings);
+    passed &= compareAgainstGoldenRenders(settings);
+    
+    std::cout << "gate " << (passed ? "passed" : "FAILED") << std::endl;
+    return passed;
+}
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+    
+    RegressionGate.h
+    Created: 17 Oct 2026 5:12:37pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Benchmarks
+{
+/*
+ keeps one case's measurement for the gate, ns per sample or us per frame.
+ 'name' is the case's line without its measurements, i.e. "fft size=2048".
+ measuring the same case again replaces the earlier value.
+ */
+void record(const juce::String& name, double value);
+
+struct GateSettings
+{
+    //holds baseline.json and the golden renders
+    juce::File directory;
+    
+    //how much slower than the baseline a case may get, 0.1 is 10%
+    double threshold { 0.1 };
+    
+    //the largest difference from a golden render that still counts as identical
+    float tolerance { 1.0e-4f };
+    
+    //writes what was just measured and rendered as the new baseline instead of comparing
+    bool update { false };
+};
+
+/*
+ compares everything record()ed so far against the baseline,
+ then renders the golden cases and compares them against the stored renders.
+ prints one line per comparison and returns false if anything got slower than allowed or sounds different.
+ cases missing from the baseline are reported but don't fail.
+ */
+bool runRegressionGate(const GateSettings& settings);
+}
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+    
+    SidechainBenchmark.cpp
+    Created: 16 Oct 2026 11:52:40pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+namespace Benchmarks
+{
+/*
+ the band path without a key, with a key nobody listens to, and with every band keyed.
+ the first two should cost the same, the key is not even split unless a band uses it.
+ keying every band with a copy of the input has to compress exactly like no key at all.
+ */
+bool runSidechainBenchmark()
+{
+    static constexpr size_t NumBands = 3;
+    const auto sampleRate = 48000.0;
+    const auto numChannels = 2;
+    const auto blockSize = 512;
+    
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+    
+    struct Path
+    {
+        std::array<BandParams, NumBands> params;
+        SimpleMBComp::CompressorBands compressors, sideCompressors;
+        SimpleMBComp::BandBuffers buffers;
+        SimpleMBComp::LinearPhaseCrossovers linearPhase;
+        SimpleMBComp::MultiBandEngine<NumBands> engine { compressors, sideCompressors, buffers, linearPhase };
+        SimpleMBComp::ProcessingSnapshot snapshot;
+        
+        void prepare(const juce::dsp::ProcessSpec& spec, bool keyed)
+        {
+            for( size_t i = 0; i < NumBands; ++i )
+            {
+                params[i].threshold = -18.f;
+                params[i].sidechain = keyed;
+                params[i].attachTo(compressors[i]);
+                
+                compressors[i].prepare<float>(spec);
+                
+                buffers.floats[i].setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+                buffers.floatKeys[i].setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+            }
+            
+            engine.prepare(spec);
+            snapshot = makeSnapshot(NumBands, { 400.f, 2000.f });
+            updateFromSnapshot(snapshot, compressors, sideCompressors, engine);
+        }
+        
+        void process(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>* key)
+        {
+            auto block = juce::dsp::AudioBlock<float>(buffer);
+            const auto numSamples = block.getNumSamples();
+            for( size_t start = 0; start < numSamples; start += SimpleMBComp::TILE_SIZE )
+            {
+                auto length = juce::jmin(SimpleMBComp::TILE_SIZE, numSamples - start);
+                auto keyTile = juce::dsp::AudioBlock<const float>();
+                if( key != nullptr )
+                    keyTile = juce::dsp::AudioBlock<const float>(key->getArrayOfReadPointers(),
+                                                                 static_cast<size_t>(key->getNumChannels()),
+                                                                 start,
+                                                                 length);
+                
+                engine.process(block.getSubBlock(start, length), keyTile);
+            }
+        }
+    };
+    
+    Path unkeyed, keyed;
+    unkeyed.prepare(tileSpec, false);
+    keyed.prepare(tileSpec, true);
+    
+    juce::AudioBuffer<float> unkeyedBuffer(numChannels, blockSize), keyedBuffer(numChannels, blockSize), key(numChannels, blockSize);
+    
+    juce::Random random(0x5eed);
+    auto maxDifference = 0.f;
+    for( auto processed = 0.0; processed < sampleRate; processed += blockSize )
+    {
+        fillWithNoise(key, random);
+        unkeyedBuffer.makeCopyOf(key, true);
+        keyedBuffer.makeCopyOf(key, true);
+        
+        unkeyed.process(unkeyedBuffer, nullptr);
+        keyed.process(keyedBuffer, &key);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            for( int i = 0; i < blockSize; ++i )
+                maxDifference = juce::jmax(maxDifference, std::abs(keyedBuffer.getSample(ch, i) - unkeyedBuffer.getSample(ch, i)));
+    }
+    
+    static constexpr float tolerance = 1.0e-6f;
+    const auto passed = maxDifference <= tolerance;
+    
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto offNs = measureNsPerSample([&]() { unkeyed.process(unkeyedBuffer, nullptr); }, samplesPerRun);
+    auto unusedNs = measureNsPerSample([&]() { unkeyed.process(unkeyedBuffer, &key); }, samplesPerRun);
+    auto keyedNs = measureNsPerSample([&]() { keyed.process(keyedBuffer, &key); }, samplesPerRun);
+    
+    std::cout << "sidechain"
+              << " bands=" << NumBands
+              << " channels=" << numChannels
+              << " block=" << blockSize
+              << " rate=" << sampleRate
+              << " off_ns_per_sample=" << offNs
+              << " unused_ns_per_sample=" << unusedNs
+              << " keyed_ns_per_sample=" << keyedNs
+              << " max_difference=" << maxDifference
+              << (passed ? " ok" : " FAILED")
+              << std::endl;
+    
+    return passed;
+}
+}
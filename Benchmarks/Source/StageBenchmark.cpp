@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+    StageBenchmark.cpp
+    Created: 17 Oct 2026 3:26:09pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "RegressionGate.h"
+#include "../../Source/DSP/LinkwitzRileyFilterBank.h"
+#include "../../Source/DSP/SingleChannelSampleFifo.h"
+#include "../../Source/GUI/FFTDataGenerator.h"
+
+namespace Benchmarks
+{
+/*
+ calls process(tile) for every tile of 'block', the way the processor hands the bands a host block.
+ the block size only changes how the last tile of each block is cut.
+ */
+template<typename Func>
+void forEachTile(juce::dsp::AudioBlock<float> block, Func&& process)
+{
+    const auto numSamples = block.getNumSamples();
+    for( size_t start = 0; start < numSamples; start += SimpleMBComp::TILE_SIZE )
+        process(block.getSubBlock(start, juce::jmin(SimpleMBComp::TILE_SIZE, numSamples - start)));
+}
+
+/*
+ the minimum phase band split on its own, 3 bands.
+ */
+void runSplitCase(int numChannels, int blockSize, double sampleRate)
+{
+    static constexpr size_t NumBands = 3;
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+
+    SimpleMBComp::LinkwitzRileyFilterBank<float, NumBands> bank;
+    bank.prepare(tileSpec);
+    bank.setCutoffFrequency(0, 400.f);
+    bank.setCutoffFrequency(1, 2000.f);
+
+    std::array<juce::AudioBuffer<float>, NumBands> buffers;
+    for( auto& buffer : buffers )
+        buffer.setSize(numChannels, static_cast<int>(SimpleMBComp::TILE_SIZE));
+
+    juce::AudioBuffer<float> input(numChannels, blockSize);
+    juce::Random random(0x5eed);
+    fillWithNoise(input, random);
+
+    auto process = [&]()
+    {
+        forEachTile(juce::dsp::AudioBlock<float>(input), [&](juce::dsp::AudioBlock<float> tile)
+        {
+            std::array<juce::dsp::AudioBlock<float>, NumBands> bands;
+            for( size_t b = 0; b < NumBands; ++b )
+            {
+                bands[b] = juce::dsp::AudioBlock<float>(buffers[b]).getSubBlock(0, tile.getNumSamples());
+            }
+
+            bank.process(juce::dsp::AudioBlock<const float>(tile), bands);
+        });
+    };
+
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto ns = measureNsPerSample(process, samplesPerRun, getNumRuns(blockSize));
+
+    juce::String name;
+    name << "split"
+         << " bands=" << static_cast<int>(NumBands)
+         << " channels=" << numChannels
+         << " block=" << blockSize
+         << " rate=" << sampleRate;
+    
+    record(name, ns);
+    std::cout << name << " ns_per_sample=" << ns << std::endl;
+}
+
+/*
+ one CompressorBand, compressing, bypassed or silent (muted, or not soloed while another band is).
+ */
+void runBandCase(int numChannels, int blockSize, double sampleRate, BandState state)
+{
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+
+    BandParams params;
+    params.threshold = -18.f;
+    params.bypassed = state == BandState::Bypass;
+
+    CompressorBand band;
+    params.attachTo(band);
+    band.prepare<float>(tileSpec);
+    band.updateCompressorSettings(band.readParameters());
+
+    //a solo on another band silences this one just like a mute
+    band.setAudible(state == BandState::Normal || state == BandState::Bypass);
+
+    juce::AudioBuffer<float> noise(numChannels, blockSize), buffer(numChannels, blockSize);
+    juce::Random random(0x5eed);
+    fillWithNoise(noise, random);
+
+    auto process = [&]()
+    {
+        buffer.makeCopyOf(noise, true);
+        forEachTile(juce::dsp::AudioBlock<float>(buffer), [&band](juce::dsp::AudioBlock<float> tile)
+        {
+            band.process(tile);
+        });
+    };
+
+    //the fade in or out is over long before this
+    for( auto processed = 0.0; processed < sampleRate * 0.1; processed += blockSize )
+        process();
+
+    const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+    auto ns = measureNsPerSample(process, samplesPerRun, getNumRuns(blockSize));
+
+    juce::String name;
+    name << "band"
+         << " channels=" << numChannels
+         << " block=" << blockSize
+         << " rate=" << sampleRate
+         << " state=" << getName(state);
+    
+    record(name, ns);
+    std::cout << name << " ns_per_sample=" << ns << std::endl;
+}
+
+/*
+ what processBlock does for each analyzer channel, plus taking the finished buffers out the way the editor does.
+ */
+void runAnalyzerFifoCase(int blockSize)
+{
+    using BlockType = juce::AudioBuffer<float>;
+    SimpleMBComp::SingleChannelSampleFifo<BlockType> fifo { SimpleMBComp::Channel::Left };
+    fifo.prepare(blockSize, juce::AudioChannelSet::stereo());
+
+    juce::AudioBuffer<float> input(2, blockSize);
+    juce::Random random(0x5eed);
+    fillWithNoise(input, random);
+
+    BlockType pulled(1, blockSize);
+    auto process = [&]()
+    {
+        fifo.update(input);
+        while( fifo.getAudioBuffer(pulled) ) { }
+    };
+
+    auto ns = measureNsPerSample(process, static_cast<size_t>(blockSize), getNumRuns(blockSize));
+
+    juce::String name;
+    name << "analyzer_fifo block=" << blockSize;
+    
+    record(name, ns);
+    std::cout << name << " ns_per_sample=" << ns << std::endl;
+}
+
+/*
+ one analyzer frame: window, FFT, normalization and conversion to dB.
+ the frames are taken back out of the fifo the way the path producer does.
+ */
+void runFFTCase(SimpleMBComp::FFTOrder order)
+{
+    using BlockType = std::vector<float>;
+    SimpleMBComp::FFTDataGenerator<BlockType> generator;
+    generator.changeOrder(order);
+
+    const auto fftSize = generator.getFFTSize();
+    juce::AudioBuffer<float> input(1, fftSize);
+    juce::Random random(0x5eed);
+    fillWithNoise(input, random);
+
+    BlockType pulled(static_cast<size_t>(fftSize * 2));
+    auto process = [&]()
+    {
+        generator.produceFFTDataForRendering(input, SimpleMBComp::NEG_INFINITY);
+        while( generator.getFFTData(pulled) ) { }
+    };
+
+    auto nsPerSample = measureNsPerSample(process, static_cast<size_t>(fftSize), getNumRuns(fftSize));
+
+    juce::String name;
+    name << "fft size=" << fftSize;
+    
+    record(name, nsPerSample);
+    std::cout << name
+              << " ns_per_sample=" << nsPerSample
+              << " us_per_frame=" << nsPerSample * fftSize / 1000.0
+              << std::endl;
+}
+
+bool runStageBenchmark()
+{
+    for( auto sampleRate : SWEEP_SAMPLE_RATES )
+    {
+        for( auto blockSize : SWEEP_BLOCK_SIZES )
+        {
+            runSplitCase(2, blockSize, sampleRate);
+            runBandCase(2, blockSize, sampleRate, BandState::Normal);
+        }
+    }
+
+    for( auto numChannels : SWEEP_CHANNELS )
+    {
+        runSplitCase(numChannels, 512, 48000.0);
+        for( auto state : { BandState::Normal, BandState::Mute, BandState::Bypass } )
+            runBandCase(numChannels, 512, 48000.0, state);
+    }
+
+    for( auto blockSize : SWEEP_BLOCK_SIZES )
+        runAnalyzerFifoCase(blockSize);
+
+    for( auto order : { SimpleMBComp::FFTOrder::order2048, SimpleMBComp::FFTOrder::order4096, SimpleMBComp::FFTOrder::order8192 } )
+        runFFTCase(order);
+
+    //these stages have nothing to check, only to time
+    return true;
+}
+}
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+    
+    UpdateStateBenchmark.cpp
+    Created: 16 Oct 2026 4:18:53pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/MultiBandEngine.h"
+
+namespace Benchmarks
+{
+/*
+ measures what updateState() costs per block at small block sizes,
+ once with every parameter holding still and once with every parameter automated.
+ the automated case pays for every coefficient, which is what every block used to cost.
+ */
+bool runUpdateStateBenchmark()
+{
+    static constexpr size_t NumBands = 3;
+    const auto sampleRate = 48000.0;
+    const auto numChannels = 2;
+    
+    std::array<BandParams, NumBands> params;
+    SimpleMBComp::CompressorBands compressors, sideCompressors;
+    SimpleMBComp::BandBuffers buffers;
+    SimpleMBComp::LinearPhaseCrossovers linearPhase;
+    SimpleMBComp::MultiBandEngine<NumBands> engine(compressors, sideCompressors, buffers, linearPhase);
+    
+    const auto tileSpec = juce::dsp::ProcessSpec { sampleRate,
+                                                   static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE),
+                                                   static_cast<juce::uint32>(numChannels) };
+    for( size_t i = 0; i < NumBands; ++i )
+    {
+        auto& comp = compressors[i];
+        params[i].attachTo(comp);
+        
+        comp.prepare<float>(tileSpec);
+        buffers.floats[i].setSize(numChannels, static_cast<int>(SimpleMBComp::TILE_SIZE));
+    }
+    
+    engine.prepare(tileSpec);
+    
+    SimpleMBComp::CrossoverFrequencies frequencies { 400.f, 2000.f };
+    auto snapshot = makeSnapshot(NumBands, frequencies);
+    
+    auto updateState = [&]()
+    {
+        snapshot.crossovers = frequencies;
+        updateFromSnapshot(snapshot, compressors, sideCompressors, engine);
+    };
+    
+    //moves every parameter a little, the way automation would
+    auto automate = [&, toggle = false]() mutable
+    {
+        toggle = ! toggle;
+        auto offset = toggle ? 1.f : 0.f;
+        for( auto& p : params )
+        {
+            p.attack = 50.f + offset;
+            p.release = 250.f + offset;
+            p.threshold = -12.f + offset;
+            p.knee = 6.f + offset;
+            p.ratio = toggle ? 3 : 4;
+        }
+        
+        frequencies[0] = 400.f + offset;
+        frequencies[1] = 2000.f + offset;
+    };
+    
+    juce::Random random(0x5eed);
+    
+    for( auto blockSize : { 16, 32, 64, 128 } )
+    {
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        fillWithNoise(buffer, random);
+        
+        auto process = [&]()
+        {
+            auto block = juce::dsp::AudioBlock<float>(buffer);
+            const auto numSamples = block.getNumSamples();
+            for( size_t start = 0; start < numSamples; start += SimpleMBComp::TILE_SIZE )
+                engine.process(block.getSubBlock(start, juce::jmin(SimpleMBComp::TILE_SIZE, numSamples - start)), {});
+        };
+        
+        const auto samplesPerRun = static_cast<size_t>(blockSize * numChannels);
+        
+        auto processNs = measureNsPerSample(process, samplesPerRun);
+        
+        auto staticNs = measureNsPerSample(updateState, 1, 1000);
+        
+        auto automatedNs = measureNsPerSample([&]() { automate(); updateState(); }, 1, 1000);
+        auto automateOnlyNs = measureNsPerSample(automate, 1, 1000);
+        automatedNs = juce::jmax(0.0, automatedNs - automateOnlyNs);
+        
+        const auto processNsPerBlock = processNs * static_cast<double>(samplesPerRun);
+        
+        std::cout << "update_state"
+                  << " bands=" << NumBands
+                  << " channels=" << numChannels
+                  << " block=" << blockSize
+                  << " rate=" << sampleRate
+                  << " static_ns_per_block=" << staticNs
+                  << " automated_ns_per_block=" << automatedNs
+                  << " process_ns_per_block=" << processNsPerBlock
+                  << " static_overhead_percent=" << 100.0 * staticNs / (staticNs + processNsPerBlock)
+                  << " automated_overhead_percent=" << 100.0 * automatedNs / (automatedNs + processNsPerBlock)
+                  << std::endl;
+    }
+    
+    return true;
+}
+}
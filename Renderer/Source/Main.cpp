@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+    
+    Main.cpp
+    Created: 17 Oct 2026 1:14:20pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+namespace
+{
+void printUsage()
+{
+    std::cout << "usage: SimpleMBCompRenderer --state <file> --output <directory> [--threads <n>] [--block <samples>] <files or directories...>" << std::endl
+              << "  --state    a plugin state saved by getStateInformation(), applied to every file" << std::endl
+              << "  --output   where the rendered files go, under the same names" << std::endl
+              << "  --threads  how many files are rendered at once, the number of cores by default" << std::endl
+              << "  --block    the block size the processor is called with, 512 by default" << std::endl
+              << "directories are searched recursively for wav, aiff, flac and ogg files." << std::endl;
+}
+}
+
+int main (int argc, char* argv[])
+{
+    //the processors' parameters and value trees expect a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    Renderer::RenderSettings settings;
+    juce::File stateFile;
+    juce::Array<juce::File> inputs;
+    
+    for( int i = 1; i < argc; ++i )
+    {
+        auto arg = juce::String(argv[i]);
+        auto hasValue = i + 1 < argc;
+        
+        if( arg == "--state" && hasValue )
+            stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if( arg == "--output" && hasValue )
+            settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if( arg == "--threads" && hasValue )
+            settings.numThreads = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if( arg == "--block" && hasValue )
+            settings.blockSize = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if( arg.startsWith("--") )
+        {
+            printUsage();
+            return 1;
+        }
+        else
+        {
+            auto file = juce::File::getCurrentWorkingDirectory().getChildFile(arg);
+            if( file.isDirectory() )
+                inputs.addArray(file.findChildFiles(juce::File::findFiles, true, "*.wav;*.aif;*.aiff;*.flac;*.ogg"));
+            else
+                inputs.add(file);
+        }
+    }
+    
+    if( ! stateFile.existsAsFile() || settings.outputDirectory == juce::File() || inputs.isEmpty() )
+    {
+        printUsage();
+        return 1;
+    }
+    
+    if( ! stateFile.loadFileAsData(settings.state) )
+    {
+        std::cout << "can't read " << stateFile.getFullPathName() << std::endl;
+        return 1;
+    }
+    
+    if( settings.outputDirectory.createDirectory().failed() )
+    {
+        std::cout << "can't create " << settings.outputDirectory.getFullPathName() << std::endl;
+        return 1;
+    }
+    
+    //no more threads than files
+    settings.numThreads = juce::jmin(settings.numThreads, inputs.size());
+    
+    Renderer::OfflineRenderer renderer(settings);
+    
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+    auto results = renderer.render(inputs, [](const Renderer::RenderResult& result)
+    {
+        std::cout << "render"
+                  << " file=" << result.input.getFullPathName();
+        
+        if( result.succeeded() )
+        {
+            std::cout << " audio_seconds=" << result.audioSeconds
+                      << " render_seconds=" << result.renderSeconds
+                      << " realtime_factor=" << result.getRealtimeFactor()
+                      << " ok";
+        }
+        else
+        {
+            std::cout << " FAILED " << result.error;
+        }
+        
+        std::cout << std::endl;
+    });
+    const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+    
+    auto numFailed = 0;
+    auto audioSeconds = 0.0;
+    for( const auto& result : results )
+    {
+        if( result.succeeded() )
+            audioSeconds += result.audioSeconds;
+        else
+            ++numFailed;
+    }
+    
+    std::cout << "total"
+              << " files=" << results.size()
+              << " failed=" << numFailed
+              << " threads=" << settings.numThreads
+              << " audio_seconds=" << audioSeconds
+              << " wall_seconds=" << wallSeconds
+              << " realtime_factor=" << (wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0)
+              << std::endl;
+    
+    return numFailed == 0 ? 0 : 1;
+}
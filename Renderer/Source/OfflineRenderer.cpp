@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+    
+    OfflineRenderer.cpp
+    Created: 17 Oct 2026 1:14:20pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+#include "../../Source/BusLayouts.h"
+
+namespace Renderer
+{
+OfflineRenderer::OfflineRenderer(const RenderSettings& settingsToUse) : settings(settingsToUse)
+{
+    formatManager.registerBasicFormats();
+    
+    for( int i = 0; i < juce::jmax(1, settings.numThreads); ++i )
+    {
+        auto processor = std::make_unique<SimpleMBCompAudioProcessor>();
+        processor->setNonRealtime(true);
+        
+        //the files are already rendered in parallel, band workers would only fight them for the cores
+        processor->setParallelBandsEnabled(false);
+        processor->setStateInformation(settings.state.getData(), static_cast<int>(settings.state.getSize()));
+        processors.push_back(std::move(processor));
+    }
+}
+
+OfflineRenderer::~OfflineRenderer() = default;
+
+std::vector<RenderResult> OfflineRenderer::render(const juce::Array<juce::File>& inputs,
+                                                  std::function<void(const RenderResult&)> onFinished)
+{
+    std::vector<RenderResult> results(static_cast<size_t>(inputs.size()));
+    std::atomic<int> nextInput { 0 };
+    juce::CriticalSection finishedLock;
+    
+    //signalled by whichever job finishes last
+    std::atomic<int> numJobsRunning { static_cast<int>(processors.size()) };
+    juce::WaitableEvent allFinished;
+    
+    /*
+     every job keeps taking the next file until there are none left,
+     so one long file doesn't hold up the files queued behind it.
+     */
+    juce::ThreadPool pool(static_cast<int>(processors.size()));
+    for( auto& processor : processors )
+    {
+        pool.addJob([this, &inputs, &results, &nextInput, &finishedLock, &onFinished, &numJobsRunning, &allFinished, p = processor.get()]()
+        {
+            for( auto i = nextInput++; i < inputs.size(); i = nextInput++ )
+            {
+                auto result = renderFile(*p, inputs[i]);
+                
+                const juce::ScopedLock lock(finishedLock);
+                if( onFinished )
+                    onFinished(result);
+                
+                results[static_cast<size_t>(i)] = std::move(result);
+            }
+            
+            if( --numJobsRunning == 0 )
+                allFinished.signal();
+        });
+    }
+    
+    allFinished.wait();
+    
+    return results;
+}
+
+RenderResult OfflineRenderer::renderFile(SimpleMBCompAudioProcessor& processor, const juce::File& input)
+{
+    RenderResult result;
+    result.input = input;
+    result.output = settings.outputDirectory.getChildFile(input.getFileName());
+    
+    auto fail = [&result](const juce::String& error)
+    {
+        result.error = error;
+        return result;
+    };
+    
+    if( result.output == input )
+        return fail("the output would replace the input");
+    
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+    
+    auto reader = createReader(input);
+    if( reader == nullptr )
+        return fail("can't read this file");
+    
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    const auto sampleRate = reader->sampleRate;
+    const auto length = reader->lengthInSamples;
+    
+    //the main bus as wide as the file
+    processor.releaseResources();
+    if( ! SimpleMBComp::setMainBusWidth(processor, numChannels) )
+        return fail("no bus layout with " + juce::String(numChannels) + " channels");
+    
+    processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+    processor.prepareToPlay(sampleRate, settings.blockSize);
+    
+    //the rendered file keeps the format, bit depth and metadata of the input
+    auto* format = formatManager.findFormatForFileExtension(input.getFileExtension());
+    jassert(format != nullptr);
+    
+    auto bitDepths = format->getPossibleBitDepths();
+    auto bitsPerSample = static_cast<int>(reader->bitsPerSample);
+    if( ! bitDepths.contains(bitsPerSample) )
+        bitsPerSample = bitDepths.getLast();
+    
+    result.output.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(result.output);
+    if( stream->failedToOpen() )
+        return fail("can't write " + result.output.getFullPathName());
+    
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                             sampleRate,
+                                                                             static_cast<unsigned int>(numChannels),
+                                                                             bitsPerSample,
+                                                                             reader->metadataValues,
+                                                                             0));
+    if( writer == nullptr )
+        return fail("can't write " + juce::String(bitsPerSample) + " bit " + format->getFormatName());
+    
+    //the writer owns it now
+    stream.release();
+    
+    /*
+     the output lags the input by the latency.
+     that many samples are left off the start of the rendered file and silence is fed in after the end,
+     so the rendered file lines up with the input and is just as long.
+     */
+    const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+    const auto numSamplesToProcess = length + latency;
+    
+    juce::AudioBuffer<float> buffer(juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()),
+                                    settings.blockSize);
+    juce::MidiBuffer midi;
+    
+    for( juce::int64 position = 0; position < numSamplesToProcess; position += settings.blockSize )
+    {
+        const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(settings.blockSize, numSamplesToProcess - position));
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+        
+        block.clear();
+        if( position < length )
+            reader->read(&block, 0, static_cast<int>(juce::jmin<juce::int64>(numSamples, length - position)), position, true, true);
+        
+        processor.processBlock(block, midi);
+        
+        const auto skip = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, latency - position));
+        if( skip < numSamples && ! writer->writeFromAudioSampleBuffer(block, skip, numSamples - skip) )
+            return fail("writing " + result.output.getFullPathName() + " failed");
+    }
+    
+    writer.reset();
+    processor.releaseResources();
+    
+    result.audioSeconds = static_cast<double>(length) / sampleRate;
+    result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+    
+    return result;
+}
+
+std::unique_ptr<juce::AudioFormatReader> OfflineRenderer::createReader(const juce::File& file)
+{
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+    if( format == nullptr )
+        return {};
+    
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+    if( mapped != nullptr && mapped->mapEntireFile() )
+        return mapped;
+    
+    return std::unique_ptr<juce::AudioFormatReader>(format->createReaderFor(new juce::FileInputStream(file), true));
+}
+}
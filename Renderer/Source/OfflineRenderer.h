@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+    
+    OfflineRenderer.h
+    Created: 17 Oct 2026 1:14:20pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../../Source/PluginProcessor.h"
+
+namespace Renderer
+{
+struct RenderSettings
+{
+    //what getStateInformation() saved, applied to every file
+    juce::MemoryBlock state;
+    
+    //rendered files keep their name and format
+    juce::File outputDirectory;
+    
+    int blockSize { 512 };
+    int numThreads { juce::SystemStats::getNumCpus() };
+};
+
+struct RenderResult
+{
+    juce::File input, output;
+    juce::String error;
+    
+    double audioSeconds { 0.0 };
+    double renderSeconds { 0.0 };
+    
+    bool succeeded() const { return error.isEmpty(); }
+    
+    //seconds of audio rendered per second of wall clock time, reading and writing included
+    double getRealtimeFactor() const { return renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0; }
+};
+
+/*
+ renders files with one processor per thread.
+ the processors are created and given the state on the calling thread,
+ which has to be the message thread.  they never get an editor.
+ */
+struct OfflineRenderer
+{
+    explicit OfflineRenderer(const RenderSettings& settings);
+    ~OfflineRenderer();
+    
+    /*
+     renders every file in 'inputs' and returns their results in the same order.
+     'onFinished' is called from the worker threads, one at a time, as each file is done.
+     */
+    std::vector<RenderResult> render(const juce::Array<juce::File>& inputs,
+                                     std::function<void(const RenderResult&)> onFinished);
+private:
+    RenderSettings settings;
+    juce::AudioFormatManager formatManager;
+    std::vector<std::unique_ptr<SimpleMBCompAudioProcessor>> processors;
+    
+    RenderResult renderFile(SimpleMBCompAudioProcessor& processor, const juce::File& input);
+    
+    /*
+     a memory mapped reader where the format has one (wav, aiff), a streaming one otherwise (flac, ogg).
+     */
+    std::unique_ptr<juce::AudioFormatReader> createReader(const juce::File& file);
+    
+    JUCE_DECLARE_NON_COPYABLE(OfflineRenderer)
+};
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    BusLayouts.h
+    Created: 19 Oct 2026 9:42:06am
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace SimpleMBComp
+{
+/*
+ the main bus 'numChannels' wide, no sidechain.
+ false if the processor doesn't support that many channels.
+ */
+inline bool setMainBusWidth(juce::AudioProcessor& processor, int numChannels)
+{
+    auto layout = processor.getBusesLayout();
+    const auto channels = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+    layout.inputBuses.getReference(0) = channels;
+    layout.outputBuses.getReference(0) = channels;
+    for( int bus = 1; bus < layout.inputBuses.size(); ++bus )
+        layout.inputBuses.getReference(bus) = juce::AudioChannelSet::disabled();
+    
+    return processor.setBusesLayout(layout);
+}
+} //end namespace SimpleMBComp
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    BandWorkerPool.cpp
+    Created: 17 Oct 2026 9:14:37pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#include "BandWorkerPool.h"
+#include "Params.h"
+
+namespace SimpleMBComp
+{
+struct BandWorkerPool::Worker : juce::Thread
+{
+    Worker(BandWorkerPool& p, int index) : juce::Thread("Band Worker " + juce::String(index)), pool(p) { }
+
+    void run() override
+    {
+        while( ! pool.isStopping.load(std::memory_order_acquire) )
+        {
+            pool.wakeUp.wait();
+
+            //once woken, keep going while anyone has tasks left
+            while( pool.runPublishedTasks() ) { }
+        }
+    }
+
+    BandWorkerPool& pool;
+};
+
+/*
+ one task per band and the caller takes one of them,
+ so one job never keeps more workers than this busy.
+ */
+static constexpr int MAX_WORKERS = static_cast<int>(Params::MAX_BANDS) - 1;
+
+BandWorkerPool::BandWorkerPool()
+{
+    const auto numWorkers = juce::jlimit(0, MAX_WORKERS, juce::SystemStats::getNumPhysicalCpus() - 1);
+    for( int i = 0; i < numWorkers; ++i )
+    {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+        
+        //the audio thread waits on them, so they are scheduled like it where the system allows that
+        if( ! workers.back()->startRealtimeThread(juce::Thread::RealtimeOptions()) )
+            workers.back()->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+BandWorkerPool::~BandWorkerPool()
+{
+    isStopping.store(true, std::memory_order_release);
+
+    for( size_t i = 0; i < workers.size(); ++i )
+        wakeUp.post();
+
+    for( auto& worker : workers )
+        worker->stopThread(1000);
+}
+
+/*
+ a slot's state: the generation in the top 32 bits, the number of tasks in the next 16, the next task in the lowest 16.
+ incrementing it claims the next task.
+ */
+static constexpr juce::uint64 MAX_TASKS = 0xffff;
+
+static juce::uint64 packState(juce::uint32 generation, juce::uint64 numTasks)
+{
+    return (static_cast<juce::uint64>(generation) << 32) | (numTasks << 16);
+}
+
+static size_t getNumTasks(juce::uint64 state) { return static_cast<size_t>((state >> 16) & MAX_TASKS); }
+static size_t getNextTask(juce::uint64 state) { return static_cast<size_t>(state & MAX_TASKS); }
+
+bool BandWorkerPool::Slot::runTasks()
+{
+    auto didAnything = false;
+    auto current = state.load(std::memory_order_acquire);
+    while( getNextTask(current) < getNumTasks(current) )
+    {
+        if( ! state.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_acquire) )
+            continue;
+
+        //the job can't be taken back out while one of its tasks is unfinished, so 'function' and 'context' are still its own
+        function(context, getNextTask(current));
+
+        //publishes what the task wrote to the thread waiting for the job
+        auto isLast = numFinished.fetch_add(1) + 1 == getNumTasks(current);
+        if( isLast && isSleeping.exchange(false) )
+            finished.post();
+        
+        didAnything = true;
+
+        current = state.load(std::memory_order_acquire);
+    }
+
+    return didAnything;
+}
+
+/*
+ how long the publishing thread spins on tasks a worker started before it goes to sleep.
+ a worker that isn't preempted finishes a band in about this long.
+ */
+static constexpr double MAX_SPIN_SECONDS = 0.0002;
+
+void BandWorkerPool::Slot::waitForTasks(size_t numTasks)
+{
+    const auto deadline = juce::Time::getHighResolutionTicks()
+                        + juce::Time::secondsToHighResolutionTicks(MAX_SPIN_SECONDS);
+    
+    while( numFinished.load(std::memory_order_acquire) < numTasks )
+    {
+        if( juce::Time::getHighResolutionTicks() < deadline )
+        {
+            juce::Thread::yield();
+            continue;
+        }
+        
+        /*
+         a worker that finishes the last task after this sees the flag and posts.
+         one that finished it in the meantime either took the flag, and posts, or didn't, and won't.
+         */
+        isSleeping.store(true);
+        if( numFinished.load() < numTasks || ! isSleeping.exchange(false) )
+            finished.wait();
+        
+        break;
+    }
+}
+
+bool BandWorkerPool::runPublishedTasks()
+{
+    auto didAnything = false;
+    for( auto& slot : slots )
+        didAnything |= slot.runTasks();
+
+    return didAnything;
+}
+
+void BandWorkerPool::run(size_t numTasks, TaskFunction function, void* context)
+{
+    Slot* published = nullptr;
+    if( numTasks > 1 && numTasks <= MAX_TASKS && ! workers.empty() )
+    {
+        for( auto& slot : slots )
+        {
+            auto isTaken = false;
+            if( slot.isTaken.compare_exchange_strong(isTaken, true, std::memory_order_acquire) )
+            {
+                published = &slot;
+                break;
+            }
+        }
+    }
+
+    if( published == nullptr )
+    {
+        for( size_t i = 0; i < numTasks; ++i )
+            function(context, i);
+
+        return;
+    }
+
+    published->function = function;
+    published->context = context;
+    published->numFinished.store(0, std::memory_order_relaxed);
+    published->state.store(packState(++published->generation, numTasks), std::memory_order_release);
+
+    //the caller takes a task too, so one worker fewer than there are tasks is enough
+    const auto numToWake = juce::jmin(numTasks - 1, workers.size());
+    for( size_t i = 0; i < numToWake; ++i )
+        wakeUp.post();
+
+    //everything no worker has claimed yet runs right here
+    published->runTasks();
+
+    //only tasks a worker has already started are left
+    published->waitForTasks(numTasks);
+
+    published->isTaken.store(false, std::memory_order_release);
+}
+} //end namespace SimpleMBComp
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    BandWorkerPool.h
+    Created: 17 Oct 2026 9:14:37pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Semaphore.h"
+
+namespace SimpleMBComp
+{
+/*
+ worker threads shared by every instance of the plugin in the process.
+ hold one through juce::SharedResourcePointer<BandWorkerPool>, the threads exist while anyone does.
+
+ every instance that hands out work publishes it in one of a fixed number of job slots.
+ idle workers take the next task from whichever job still has tasks left,
+ so a worker that finished one instance's bands moves straight on to another's.
+ this is a shared queue of jobs, not a work stealing scheduler: nobody owns a task until it claims it.
+
+ the thread handing out the work takes tasks from its own job as well, so it never waits on a
+ worker that is busy elsewhere, and with every slot taken it simply runs all the tasks itself.
+ once nothing is left to claim it only waits for the tasks a worker has already started.
+ a started task writes into the caller's buffers, so it can't be abandoned.  the caller spins on it
+ for a short while only, then sleeps until it finishes, so it never keeps a preempted worker off its core.
+ */
+struct BandWorkerPool
+{
+    BandWorkerPool();
+    ~BandWorkerPool();
+
+    /*
+     calls task(i) once for every i in [0, numTasks) and returns when all of them have finished.
+     the calls run on this thread and on whichever workers are free, in no particular order.
+     never allocates and never takes a lock, waking the workers posts to a semaphore and a
+     late worker is waited for on one.
+     */
+    template<typename Func>
+    void forEach(size_t numTasks, Func& task)
+    {
+        run(numTasks, [](void* context, size_t index) { (*static_cast<Func*>(context))(index); }, &task);
+    }
+
+    size_t getNumWorkers() const { return workers.size(); }
+private:
+    using TaskFunction = void (*)(void* context, size_t index);
+
+    /*
+     one published job.
+     'state' packs the job's generation, the next task and the number of tasks into one word,
+     so claiming a task is a single compare and swap that fails for a job that was replaced in the meantime.
+     a worker still looking at a slot after its job was taken back out only ever touches the slot,
+     so the thread that published the job never has to wait for it.
+     */
+    struct Slot
+    {
+        std::atomic<juce::uint64> state { 0 };
+        std::atomic<size_t> numFinished { 0 };
+        std::atomic<bool> isTaken { false };
+
+        //set once the publishing thread stopped spinning, whoever finishes the last task posts 'finished'
+        std::atomic<bool> isSleeping { false };
+        Semaphore finished;
+
+        //written by the publishing thread before 'state' publishes them
+        TaskFunction function { nullptr };
+        void* context { nullptr };
+        juce::uint32 generation { 0 };
+
+        //true while this call did any of the tasks
+        bool runTasks();
+
+        //returns once all the tasks have finished
+        void waitForTasks(size_t numTasks);
+    };
+
+    //more instances handing out work at the same time than this run their tasks on their own
+    static constexpr size_t MAX_JOBS = 64;
+    std::array<Slot, MAX_JOBS> slots;
+
+    void run(size_t numTasks, TaskFunction function, void* context);
+
+    //true while a job had any tasks left for the calling worker
+    bool runPublishedTasks();
+
+    Semaphore wakeUp;
+
+    struct Worker;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> isStopping { false };
+
+    JUCE_DECLARE_NON_COPYABLE(BandWorkerPool)
+};
+} //end namespace SimpleMBComp
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+    
+    Compressor.h
+    Created: 16 Oct 2026 6:11:40pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Kernels.h"
+#include "LaneVector.h"
+#include "Params.h"
+
+namespace SimpleMBComp
+{
+/*
+ 1 - 1 / ratio for every ratio choice.
+ the gain computer reduces the level above the threshold by this many dB per dB.
+ */
+template<size_t N>
+constexpr std::array<float, N> makeReductionSlopes(const std::array<float, N>& ratios)
+{
+    std::array<float, N> slopes {};
+    for( size_t i = 0; i < N; ++i )
+        slopes[i] = 1.f - 1.f / ratios[i];
+    
+    return slopes;
+}
+
+static constexpr auto REDUCTION_SLOPES = makeReductionSlopes(Params::RATIO_CHOICES);
+
+/*
+ a feed-forward compressor that works in the log domain:
+     level (dB) -> soft knee gain computer -> gain reduction (dB) -> attack/release envelope -> gain
+ 
+ smoothing the gain reduction instead of the level keeps attack and release
+ independent of how far over the threshold the signal is.
+ the envelope of every channel runs in its own SIMD lane.
+ 
+ the gain reduction envelope of the last block stays readable until the next one,
+ and the envelope state can be handed to another instance running at a different rate.
+ */
+template<typename SampleType>
+struct Compressor
+{
+    void setThreshold(SampleType newThresholdDb) { thresholdDb = newThresholdDb; }
+    
+    //width in dB of the region around the threshold where the ratio fades in.  0 is a hard knee.
+    void setKnee(SampleType newKneeDb)
+    {
+        jassert(newKneeDb >= static_cast<SampleType>(0.0));
+        kneeDb = newKneeDb;
+    }
+    
+    void setRatio(SampleType newRatio)
+    {
+        jassert(newRatio >= static_cast<SampleType>(1.0));
+        reductionSlope = static_cast<SampleType>(1.0) - static_cast<SampleType>(1.0) / newRatio;
+    }
+    
+    //'index' into Params::RATIO_CHOICES
+    void setRatioIndex(size_t index)
+    {
+        reductionSlope = static_cast<SampleType>(REDUCTION_SLOPES[index]);
+    }
+    
+    void setAttack(SampleType newAttackMs) { attackMs = newAttackMs; updateBallistics(); }
+    void setRelease(SampleType newReleaseMs) { releaseMs = newReleaseMs; updateBallistics(); }
+    
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        jassert(spec.sampleRate > 0);
+        jassert(spec.numChannels > 0);
+        
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<size_t>(spec.numChannels);
+        
+        reduction.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+        envelope.assign(getNumLaneVectors<SampleType>(numChannels), Lanes());
+        lanes.assign(envelope.size(), Lanes());
+        
+        updateBallistics();
+        reset();
+    }
+    
+    void reset()
+    {
+        std::fill(envelope.begin(), envelope.end(), Lanes());
+        reduction.clear();
+        numSamplesInEnvelope = 0;
+    }
+    
+    /*
+     continues from where 'other' left off, so switching between two instances
+     (i.e. the host rate and an oversampled one) doesn't restart the envelope from 0 dB.
+     */
+    void copyStateFrom(const Compressor& other)
+    {
+        jassert(other.envelope.size() == envelope.size());
+        envelope = other.envelope;
+    }
+    
+    /*
+     runs the detector over 'input' and writes the gain for every sample into 'gains'
+     */
+    void computeGains(const juce::dsp::AudioBlock<const SampleType>& input, juce::dsp::AudioBlock<SampleType>& gains)
+    {
+        const auto numSamples = input.getNumSamples();
+        jassert(gains.getNumChannels() >= input.getNumChannels() && gains.getNumSamples() >= numSamples);
+        
+        computeGainReduction(input);
+        
+        const auto& kernels = Kernels::getActiveTable<SampleType>();
+        for( size_t ch = 0; ch < input.getNumChannels(); ++ch )
+            kernels.reductionToGain(reduction.getReadPointer(static_cast<int>(ch)), gains.getChannelPointer(ch), numSamples);
+    }
+    
+    /*
+     only runs the detector, so the envelope keeps following 'input' while nothing is compressed.
+     the gain reduction envelope is updated as if 'input' had been processed.
+     */
+    void detect(const juce::dsp::AudioBlock<const SampleType>& input)
+    {
+        computeGainReduction(input);
+    }
+    
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numSamples = outputBlock.getNumSamples();
+        
+        jassert(inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert(inputBlock.getNumSamples() == numSamples);
+        
+        if( context.isBypassed )
+        {
+            outputBlock.copyFrom(inputBlock);
+            return;
+        }
+        
+        computeGainReduction(inputBlock);
+        
+        const auto& kernels = Kernels::getActiveTable<SampleType>();
+        for( size_t ch = 0; ch < outputBlock.getNumChannels(); ++ch )
+        {
+            kernels.applyReduction(reduction.getReadPointer(static_cast<int>(ch)),
+                                   inputBlock.getChannelPointer(ch),
+                                   outputBlock.getChannelPointer(ch),
+                                   numSamples);
+        }
+    }
+    
+    /*
+     the gain reduction in dB (>= 0) of every sample of the last block that was processed
+     */
+    juce::dsp::AudioBlock<const SampleType> getGainReductionEnvelope() const
+    {
+        return juce::dsp::AudioBlock<const SampleType>(reduction.getArrayOfReadPointers(),
+                                                       numChannels,
+                                                       numSamplesInEnvelope);
+    }
+    
+    //the gain reduction in dB (>= 0) 'channel' ended the last block with
+    SampleType getGainReductionDb(size_t channel) const
+    {
+        jassert(channel < numChannels);
+        return reinterpret_cast<const SampleType*>(envelope.data())[channel];
+    }
+private:
+    using Lanes = LaneVectorOf<SampleType>;
+    
+    //-100 dB.  anything quieter is treated as this level, so silence doesn't take the log of 0
+    static constexpr SampleType MIN_LEVEL = static_cast<SampleType>(1.0e-5);
+    
+    SampleType thresholdDb = 0.0, kneeDb = 0.0, reductionSlope = 0.0;
+    SampleType attackMs = 1.0, releaseMs = 100.0;
+    
+    //how much of the distance to the target the envelope covers per sample
+    SampleType attackStep = 1.0, releaseStep = 1.0;
+    
+    double sampleRate = 44100.0;
+    size_t numChannels = 0;
+    
+    //gain reduction per channel and sample, first from the gain computer and then smoothed in place
+    juce::AudioBuffer<SampleType> reduction;
+    size_t numSamplesInEnvelope = 0;
+    
+    std::vector<Lanes> envelope, lanes;
+    
+    void updateBallistics()
+    {
+        auto step = [sr = sampleRate](SampleType ms)
+        {
+            if( ms <= static_cast<SampleType>(0.0) )
+                return static_cast<SampleType>(1.0);
+            
+            return static_cast<SampleType>(1.0 - std::exp(-1000.0 / (static_cast<double>(ms) * sr)));
+        };
+        
+        attackStep = step(attackMs);
+        releaseStep = step(releaseMs);
+    }
+    
+    void computeGainReduction(const juce::dsp::AudioBlock<const SampleType>& input)
+    {
+        const auto numSamples = input.getNumSamples();
+        //fewer channels than prepared for are fine, i.e. only the mid or side of a stereo band
+        const auto numInputChannels = input.getNumChannels();
+        jassert(numInputChannels <= numChannels);
+        jassert(numSamples <= static_cast<size_t>(reduction.getNumSamples()));
+        
+        /*
+         the static curve, one channel at a time, then the attack/release envelope
+         with every channel in its own lane.  both loops are dispatched kernels.
+         */
+        const auto& kernels = Kernels::getActiveTable<SampleType>();
+        const auto curve = Kernels::CompressorCurve<SampleType> { thresholdDb, kneeDb, reductionSlope, MIN_LEVEL };
+        
+        for( size_t ch = 0; ch < numInputChannels; ++ch )
+            kernels.computeReduction(input.getChannelPointer(ch), reduction.getWritePointer(static_cast<int>(ch)), numSamples, curve);
+        
+        kernels.smoothReduction(reduction.getArrayOfWritePointers(),
+                                numInputChannels,
+                                numSamples,
+                                reinterpret_cast<SampleType*>(envelope.data()),
+                                reinterpret_cast<SampleType*>(lanes.data()),
+                                envelope.size() * lanesPerVector<SampleType>,
+                                attackStep,
+                                releaseStep);
+        
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        auto* state = reinterpret_cast<SampleType*>(envelope.data());
+        for( size_t l = 0; l < envelope.size() * lanesPerVector<SampleType>; ++l )
+            juce::dsp::util::snapToZero(state[l]);
+       #endif
+        
+        numSamplesInEnvelope = numSamples;
+    }
+};
+} //end namespace SimpleMBComp
@@ -10,36 +10,402 @@
 
 #include "CompressorBand.h"
 
+template<typename SampleType>
 void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
 {
-    compressor.prepare(spec);
+    isUsingDoublePrecision = std::is_same_v<SampleType, double>;
+    
+    auto& dsp = getDSP<SampleType>();
+    for( size_t order = 0; order < NumOversamplingOrders; ++order )
+    {
+        auto factor = static_cast<juce::uint32>(1 << order);
+        dsp.compressors[order].prepare({ spec.sampleRate * factor, spec.maximumBlockSize * factor, spec.numChannels });
+        
+        if( order == 0 )
+            continue;
+        
+        //polyphase IIR half-band stages, with a fractional delay added so the latency is a whole number of samples
+        using Oversampling = juce::dsp::Oversampling<SampleType>;
+        for( auto* oversamplers : { &dsp.oversamplers, &dsp.detectorOversamplers } )
+        {
+            auto& oversampler = (*oversamplers)[order];
+            oversampler = std::make_unique<Oversampling>(spec.numChannels,
+                                                         order,
+                                                         Oversampling::filterHalfBandPolyphaseIIR,
+                                                         true,
+                                                         true);
+            oversampler->initProcessing(spec.maximumBlockSize);
+        }
+    }
+    
+    dsp.gainBuffer.setSize(static_cast<int>(spec.numChannels),
+                           static_cast<int>(spec.maximumBlockSize << Params::MAX_OVERSAMPLING_ORDER));
+    dsp.detectorBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+    
+    //also finishes any fade that was in progress
+    audibleGain.reset(spec.sampleRate, 0.005); //5 ms
+    
+    takeLevels();
+    takeGainReduction();
 }
 
-void CompressorBand::updateCompressorSettings()
+template void CompressorBand::prepare<float>(const juce::dsp::ProcessSpec&);
+template void CompressorBand::prepare<double>(const juce::dsp::ProcessSpec&);
+
+CompressorBand::Settings CompressorBand::readParameters() const
 {
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio( ratio->getCurrentChoiceName().getFloatValue() );
+    Settings settings;
+    settings.attackMs = attack->get();
+    settings.releaseMs = release->get();
+    settings.thresholdDb = threshold->get();
+    settings.kneeDb = knee->get();
+    settings.ratioIndex = ratio->getIndex();
+    settings.bypassed = bypassed->get();
+    settings.mute = mute->get();
+    settings.solo = solo->get();
+    settings.sidechain = sidechain->get();
+    
+    return settings;
 }
 
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
+void CompressorBand::updateCompressorSettings(const Settings& settings)
 {
-    auto preRMS = computeRMSLevel(buffer);
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
+    if( attackMs.update(settings.attackMs) )
+    {
+        forEachCompressor([this](auto& compressor) { compressor.setAttack(attackMs.get()); });
+    }
     
-    context.isBypassed = bypassed->get();
+    if( releaseMs.update(settings.releaseMs) )
+    {
+        forEachCompressor([this](auto& compressor) { compressor.setRelease(releaseMs.get()); });
+    }
     
-    compressor.process(context);
+    if( thresholdDb.update(settings.thresholdDb) )
+    {
+        forEachCompressor([this](auto& compressor) { compressor.setThreshold(thresholdDb.get()); });
+    }
     
-    auto postRMS = computeRMSLevel(buffer);
+    if( kneeDb.update(settings.kneeDb) )
+    {
+        forEachCompressor([this](auto& compressor) { compressor.setKnee(kneeDb.get()); });
+    }
     
-    auto convertToDb = [](auto input)
+    if( ratioIndex.update(settings.ratioIndex) )
     {
-        return juce::Decibels::gainToDecibels(input);
+        forEachCompressor([this](auto& compressor) { compressor.setRatioIndex(static_cast<size_t>(ratioIndex.get())); });
+    }
+    
+    isBypassed = settings.bypassed;
+}
+
+void CompressorBand::setOversamplingOrder(size_t order)
+{
+    jassert(order < NumOversamplingOrders);
+    if( order == oversamplingOrder )
+        return;
+    
+    oversamplingOrder = order;
+    
+    if( order == 0 )
+        isCompressingOversampled = false;
+    
+    //the latency changes anyway, so start the new rate from a clean slate
+    forEachDSP([order](auto& dsp)
+    {
+        dsp.compressors[order].reset();
+        for( auto* oversamplers : { &dsp.oversamplers, &dsp.detectorOversamplers } )
+        {
+            if( (*oversamplers)[order] != nullptr )
+                (*oversamplers)[order]->reset();
+        }
+    });
+}
+
+template<typename SampleType>
+void CompressorBand::setDelayLine(SimpleMBComp::SharedDelayLine<SampleType>& delayLine, size_t firstRow)
+{
+    getDSP<SampleType>().lookaheadDelay = &delayLine;
+    delayLineRow = firstRow;
+}
+
+template void CompressorBand::setDelayLine<float>(SimpleMBComp::SharedDelayLine<float>&, size_t);
+template void CompressorBand::setDelayLine<double>(SimpleMBComp::SharedDelayLine<double>&, size_t);
+
+void CompressorBand::setLookaheadSamples(size_t numSamples)
+{
+    lookaheadSamples = numSamples;
+}
+
+float CompressorBand::getLatencyInSamples() const
+{
+    auto latency = static_cast<float>(lookaheadSamples);
+    
+    auto oversamplingLatency = [order = oversamplingOrder](const auto& dsp)
+    {
+        const auto& oversampler = dsp.oversamplers[order];
+        return oversampler != nullptr ? static_cast<float>(oversampler->getLatencyInSamples()) : 0.f;
     };
     
-    rmsInputLevelDb.store(convertToDb(preRMS));
-    rmsOutputLevelDb.store(convertToDb(postRMS));
+    latency += isUsingDoublePrecision ? oversamplingLatency(doubleDSP) : oversamplingLatency(floatDSP);
+    
+    return latency;
+}
+
+bool CompressorBand::needsOversampling() const
+{
+    if( isBypassed )
+        return false;
+    
+    return juce::jmin(attackMs.get(), releaseMs.get()) < OVERSAMPLING_TIME_LIMIT_MS;
+}
+
+template<typename SampleType>
+void CompressorBand::compress(SimpleMBComp::Compressor<SampleType>& compressor,
+                              juce::dsp::AudioBlock<SampleType> block,
+                              juce::dsp::AudioBlock<const SampleType> detector)
+{
+    if( detector.getNumChannels() == 0 )
+    {
+        auto context = juce::dsp::ProcessContextReplacing<SampleType>(block);
+        context.isBypassed = isBypassed;
+        compressor.process(context);
+        
+        if( ! context.isBypassed )
+            trackGainReduction(compressor, block.getNumChannels());
+        
+        return;
+    }
+    
+    if( isBypassed )
+        return;
+    
+    auto gains = juce::dsp::AudioBlock<SampleType>(getDSP<SampleType>().gainBuffer)
+                    .getSubsetChannelBlock(0, block.getNumChannels())
+                    .getSubBlock(0, block.getNumSamples());
+    
+    compressor.computeGains(detector, gains);
+    block.multiplyBy(gains);
+    trackGainReduction(compressor, block.getNumChannels());
+}
+
+template<typename SampleType>
+void CompressorBand::trackGainReduction(const SimpleMBComp::Compressor<SampleType>& compressor, size_t numChannels)
+{
+    //every sample of the envelope, so a transient shorter than a tile still shows up
+    auto envelope = compressor.getGainReductionEnvelope();
+    if( envelope.getNumSamples() == 0 )
+        return;
+    
+    auto range = SimpleMBComp::GainReductionRange { std::numeric_limits<float>::max(), 0.f };
+    for( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto* reduction = envelope.getChannelPointer(ch);
+        auto minDb = reduction[0];
+        auto maxDb = reduction[0];
+        for( size_t i = 1; i < envelope.getNumSamples(); ++i )
+        {
+            minDb = juce::jmin(minDb, reduction[i]);
+            maxDb = juce::jmax(maxDb, reduction[i]);
+        }
+        
+        range.merge({ static_cast<float>(minDb), static_cast<float>(maxDb) });
+    }
+    
+    peakReductionDb = juce::jmax(peakReductionDb, range.maxDb);
+    
+    if( hasTileReduction )
+        tileReduction.merge(range);
+    else
+        tileReduction = range;
+    
+    hasTileReduction = true;
+}
+
+void CompressorBand::setAudible(bool shouldBeAudible)
+{
+    auto target = shouldBeAudible ? 1.f : 0.f;
+    if( target == audibleGain.getTargetValue() )
+        return;
+    
+    /*
+     the detector kept following the band while it was silent and the lookahead kept delaying it,
+     so both carry on from there.  only the oversampling filters, which nothing went through, are stale.
+     */
+    if( shouldBeAudible && isSilent() )
+        resetOversamplers();
+    
+    audibleGain.setTargetValue(target);
+}
+
+void CompressorBand::reset()
+{
+    forEachCompressor([](auto& compressor) { compressor.reset(); });
+    resetOversamplers();
+    
+    forEachDSP([this](auto& dsp)
+    {
+        if( dsp.lookaheadDelay != nullptr )
+            dsp.lookaheadDelay->clearRows(delayLineRow, static_cast<size_t>(dsp.gainBuffer.getNumChannels()));
+    });
+}
+
+void CompressorBand::resetOversamplers()
+{
+    forEachDSP([](auto& dsp)
+    {
+        for( auto* oversamplers : { &dsp.oversamplers, &dsp.detectorOversamplers } )
+        {
+            for( auto& oversampler : *oversamplers )
+            {
+                if( oversampler != nullptr )
+                    oversampler->reset();
+            }
+        }
+    });
+}
+
+template<typename SampleType>
+void CompressorBand::process(juce::dsp::AudioBlock<SampleType> block, juce::dsp::AudioBlock<const SampleType> key)
+{
+    jassert(std::is_same_v<SampleType, double> == isUsingDoublePrecision);
+    jassert(key.getNumChannels() == 0 || (key.getNumChannels() == block.getNumChannels()
+                                          && key.getNumSamples() == block.getNumSamples()));
+    
+    auto& dsp = getDSP<SampleType>();
+    auto& compressors = dsp.compressors;
+    
+    /*
+     nothing is compressed or heard, so the meters show no gain reduction.
+     the detector keeps following the band at the host rate though, without applying any gain,
+     so un-muting picks up the envelope a band that was never muted would have.
+     the band keeps going through its lookahead rows too, otherwise the fade in after un-muting
+     would run over the rows' worth of silence and the band would step in at full gain after it.
+     */
+    if( isSilent() )
+    {
+        //the oversampled compressor takes the envelope back over through the switch below
+        if( isCompressingOversampled )
+        {
+            compressors[0].copyStateFrom(compressors[oversamplingOrder]);
+            isCompressingOversampled = false;
+        }
+        
+        if( ! isBypassed )
+            compressors[0].detect(key.getNumChannels() > 0 ? key : juce::dsp::AudioBlock<const SampleType>(block));
+        
+        //only a copy, the delayed block isn't summed
+        if( lookaheadSamples > 0 )
+        {
+            jassert(dsp.lookaheadDelay != nullptr);
+            dsp.lookaheadDelay->process(delayLineRow, block, lookaheadSamples);
+        }
+        
+        return;
+    }
+    
+    /*
+     the detector looks at the undelayed signal or key, its gain is applied to the delayed signal.
+     the lookahead always delays at the host rate, ahead of the oversampling filters, so its rows hold
+     the same signal whichever rate the band compresses at and switching rates never replays anything stale.
+     a band without lookahead or key is its own detector.
+     */
+    auto detector = juce::dsp::AudioBlock<SampleType>();
+    auto isKeyed = key.getNumChannels() > 0;
+    if( ! isBypassed && (isKeyed || lookaheadSamples > 0) )
+    {
+        detector = juce::dsp::AudioBlock<SampleType>(dsp.detectorBuffer)
+                        .getSubsetChannelBlock(0, block.getNumChannels())
+                        .getSubBlock(0, block.getNumSamples());
+        detector.copyFrom(isKeyed ? key : juce::dsp::AudioBlock<const SampleType>(block));
+    }
+    
+    //a bypassed band is still delayed, otherwise it would no longer line up with the others
+    if( lookaheadSamples > 0 )
+    {
+        jassert(dsp.lookaheadDelay != nullptr);
+        dsp.lookaheadDelay->process(delayLineRow, block, lookaheadSamples);
+    }
+    
+    if( oversamplingOrder == 0 )
+    {
+        compress(compressors[0], block, detector);
+    }
+    else
+    {
+        /*
+         every band goes through the up and down filters, even the ones compressing at the host rate.
+         that keeps the latency and phase of all bands identical so they still sum back together.
+         */
+        auto& oversampler = *dsp.oversamplers[oversamplingOrder];
+        
+        auto useOversampling = needsOversampling();
+        if( useOversampling != isCompressingOversampled )
+        {
+            //the compressor taking over has been idle, it picks up the other one's gain reduction
+            if( useOversampling )
+                compressors[oversamplingOrder].copyStateFrom(compressors[0]);
+            else
+                compressors[0].copyStateFrom(compressors[oversamplingOrder]);
+            
+            isCompressingOversampled = useOversampling;
+        }
+        
+        auto upsampled = oversampler.processSamplesUp(block);
+        
+        /*
+         the detector goes through the same filters as the audio, so the two line up at either rate.
+         it goes all the way through even when only one of the rates is used, that keeps both filters
+         running and lets the band switch rates without a glitch in what the detector sees.
+         */
+        auto upsampledDetector = juce::dsp::AudioBlock<SampleType>();
+        if( detector.getNumChannels() > 0 )
+        {
+            auto& detectorOversampler = *dsp.detectorOversamplers[oversamplingOrder];
+            upsampledDetector = detectorOversampler.processSamplesUp(detector);
+            
+            if( useOversampling )
+                compress(compressors[oversamplingOrder], upsampled, upsampledDetector);
+            
+            detectorOversampler.processSamplesDown(detector);
+        }
+        else if( useOversampling )
+        {
+            compress(compressors[oversamplingOrder], upsampled, {});
+        }
+        
+        oversampler.processSamplesDown(block);
+        
+        if( ! useOversampling )
+            compress(compressors[0], block, detector);
+    }
+    
+    if( audibleGain.isSmoothing() )
+        block.multiplyBy(audibleGain);
+}
+
+template void CompressorBand::process<float>(juce::dsp::AudioBlock<float>, juce::dsp::AudioBlock<const float>);
+template void CompressorBand::process<double>(juce::dsp::AudioBlock<double>, juce::dsp::AudioBlock<const double>);
+
+SimpleMBComp::BandLevels CompressorBand::takeLevels()
+{
+    SimpleMBComp::BandLevels levels;
+    levels.inputPeakDb = inputLevels.getPeakDb();
+    levels.inputRmsDb = inputLevels.getRmsDb();
+    levels.outputPeakDb = outputLevels.getPeakDb();
+    levels.outputRmsDb = outputLevels.getRmsDb();
+    levels.gainReductionDb = peakReductionDb;
+    
+    inputLevels.reset();
+    outputLevels.reset();
+    peakReductionDb = 0.f;
+    
+    return levels;
+}
+
+SimpleMBComp::GainReductionRange CompressorBand::takeGainReduction()
+{
+    auto range = hasTileReduction ? tileReduction : SimpleMBComp::GainReductionRange();
+    hasTileReduction = false;
+    
+    return range;
 }
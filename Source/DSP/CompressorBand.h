@@ -13,43 +13,214 @@
 #include <JuceHeader.h>
 
 #include "../GUI/Utilities.h"
+#include "Compressor.h"
+#include "DirtyValue.h"
+#include "GainReductionHistory.h"
+#include "LevelMeter.h"
+#include "Params.h"
+#include "SharedDelayLine.h"
 
 struct CompressorBand
 {
     juce::AudioParameterFloat* attack { nullptr };
     juce::AudioParameterFloat* release { nullptr };
     juce::AudioParameterFloat* threshold { nullptr };
+    juce::AudioParameterFloat* knee { nullptr };
     juce::AudioParameterChoice* ratio { nullptr };
     juce::AudioParameterBool* bypassed { nullptr };
     juce::AudioParameterBool* mute { nullptr };
     juce::AudioParameterBool* solo { nullptr };
+    juce::AudioParameterBool* sidechain { nullptr };
     
+    /*
+     the compressors, oversamplers and buffers exist once per sample type.
+     only the ones for 'SampleType', the precision the host processes in, are prepared.
+     */
+    template<typename SampleType>
     void prepare(const juce::dsp::ProcessSpec& spec);
     
-    void updateCompressorSettings();
+    /*
+     everything the audio thread needs from the parameters above, read once per block
+     so the band sees the same values for the whole block.
+     */
+    struct Settings
+    {
+        float attackMs { 0.f };
+        float releaseMs { 0.f };
+        float thresholdDb { 0.f };
+        float kneeDb { 0.f };
+        int ratioIndex { 0 };
+        bool bypassed { false };
+        bool mute { false };
+        bool solo { false };
+        bool sidechain { false };
+    };
+    
+    Settings readParameters() const;
+    
+    /*
+     only the settings that changed since the last call are passed on.
+     */
+    void updateCompressorSettings(const Settings& settings);
+    
+    /*
+     0 compresses at the host rate, 1...MAX_OVERSAMPLING_ORDER at 2x...8x.
+     safe to call from the audio thread, everything is allocated in prepare().
+     */
+    void setOversamplingOrder(size_t order);
+    
+    /*
+     the rows [firstRow, firstRow + numChannels) of 'delayLine' hold this band's lookahead.
+     call after prepare(), the delay line has to be prepared for the longest lookahead.
+     the lookahead runs at the host rate whatever the oversampling order.
+     */
+    template<typename SampleType>
+    void setDelayLine(SimpleMBComp::SharedDelayLine<SampleType>& delayLine, size_t firstRow);
+    
+    /*
+     delays the audio by this many host rate samples while the detector keeps seeing it undelayed,
+     so the gain is already coming down when a transient arrives.
+     */
+    void setLookaheadSamples(size_t numSamples);
+    
+    //the same for every band with the same oversampling order and lookahead
+    float getLatencyInSamples() const;
+    
+    /*
+     inaudible bands (muted, or not soloed while another band is) are not compressed,
+     only their detector and lookahead keep running so they come back with the envelope and delayed audio they would have had.
+     switching between the two fades the band in or out over a few ms so skipping never clicks.
+     */
+    void setAudible(bool shouldBeAudible);
+    
+    /*
+     true once an inaudible band has faded out completely.
+     a silent band is neither compressed nor summed into the output.
+     */
+    bool isSilent() const { return ! audibleGain.isSmoothing() && audibleGain.getTargetValue() == 0.f; }
     
-    void process(juce::AudioBuffer<float>& buffer);
+    /*
+     envelopes, oversampling filters and the lookahead back to silence.
+     nothing is allocated, safe to call from the audio thread.
+     */
+    void reset();
     
-    float getRMSOutputLevelDb() const { return rmsOutputLevelDb; }
-    float getRMSInputLevelDb() const { return rmsInputLevelDb; }
+    /*
+     may be called several times per host block, once per tile.
+     while the band fades in or out the fade is applied to 'block' after compression.
+     'block' comes back delayed by getLatencyInSamples().
+     it may have fewer channels than prepare() was given, i.e. only the mid or side of a stereo band.
+     
+     a non-empty 'key' is what the detector listens to instead of 'block'.
+     it has to be as long and as wide as 'block'.
+     */
+    template<typename SampleType>
+    void process(juce::dsp::AudioBlock<SampleType> block, juce::dsp::AudioBlock<const SampleType> key = {});
+    
+    /*
+     the band's levels as it is split off and as it is summed back in.
+     filled in by the engine from the passes that already touch the samples, not by process().
+     */
+    SimpleMBComp::LevelAccumulator inputLevels, outputLevels;
+    
+    /*
+     everything measured since the last call plus the most gain reduction applied, then starts over.
+     called from the audio thread once per host block, the editor gets the result in a MeterFrame.
+     */
+    SimpleMBComp::BandLevels takeLevels();
+    
+    /*
+     the least and most gain reduction applied since the last call, then starts over.
+     called from the audio thread once per tile, {0, 0} if nothing was compressed.
+     */
+    SimpleMBComp::GainReductionRange takeGainReduction();
 private:
-    juce::dsp::Compressor<float> compressor;
+    static constexpr size_t NumOversamplingOrders = Params::MAX_OVERSAMPLING_ORDER + 1;
+    
+    template<typename SampleType>
+    struct DSP
+    {
+        /*
+         compressors[order] runs at (1 << order) times the host rate, oversamplers[order] converts to and from that rate.
+         detectorOversamplers[order] takes the detector signal through the same filters, with the same latency.
+         oversamplers[0] and detectorOversamplers[0] are never used.
+         */
+        std::array<SimpleMBComp::Compressor<SampleType>, NumOversamplingOrders> compressors;
+        std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, NumOversamplingOrders> oversamplers, detectorOversamplers;
+        
+        SimpleMBComp::SharedDelayLine<SampleType>* lookaheadDelay { nullptr };
+        
+        //one gain per channel and sample of the longest (oversampled) tile
+        juce::AudioBuffer<SampleType> gainBuffer;
+        
+        //what the detector listens to when it isn't the band itself, i.e. the key or the undelayed band
+        juce::AudioBuffer<SampleType> detectorBuffer;
+    };
     
-    std::atomic<float> rmsInputLevelDb { SimpleMBComp::NEG_INFINITY };
-    std::atomic<float> rmsOutputLevelDb { SimpleMBComp::NEG_INFINITY };
+    DSP<float> floatDSP;
+    DSP<double> doubleDSP;
+    bool isUsingDoublePrecision { false };
     
-    template<typename T>
-    float computeRMSLevel(const T& buffer)
+    template<typename SampleType>
+    DSP<SampleType>& getDSP()
     {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for( int chan = 0; chan < numChannels; ++chan )
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleDSP;
+        else
+            return floatDSP;
+    }
+    
+    //settings go to both precisions so switching precision never loses them
+    template<typename Func>
+    void forEachDSP(Func&& func)
+    {
+        func(floatDSP);
+        func(doubleDSP);
+    }
+    
+    template<typename Func>
+    void forEachCompressor(Func&& func)
+    {
+        forEachDSP([&func](auto& dsp)
         {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
-        }
-        
-        rms /= static_cast<float>(numChannels);
-        return rms;
+            for( auto& compressor : dsp.compressors )
+                func(compressor);
+        });
     }
+    
+    size_t oversamplingOrder { 0 };
+    bool isCompressingOversampled { false };
+    bool isBypassed { false };
+    
+    /*
+     attack and release times this long change the gain slowly enough not to alias,
+     so a band with both at or above it compresses at the host rate even when oversampling.
+     */
+    static constexpr float OVERSAMPLING_TIME_LIMIT_MS = 20.f;
+    bool needsOversampling() const;
+    
+    //the oversampling filters, but not the envelopes or the lookahead
+    void resetOversamplers();
+    
+    size_t delayLineRow { 0 };
+    size_t lookaheadSamples { 0 };
+    
+    //an empty 'detector' means 'block' is its own detector
+    template<typename SampleType>
+    void compress(SimpleMBComp::Compressor<SampleType>& compressor,
+                  juce::dsp::AudioBlock<SampleType> block,
+                  juce::dsp::AudioBlock<const SampleType> detector);
+    template<typename SampleType>
+    void trackGainReduction(const SimpleMBComp::Compressor<SampleType>& compressor, size_t numChannels);
+    
+    juce::SmoothedValue<float> audibleGain { 1.f };
+    
+    SimpleMBComp::DirtyValue<float> attackMs, releaseMs, thresholdDb, kneeDb;
+    SimpleMBComp::DirtyValue<int> ratioIndex;
+    
+    float peakReductionDb { 0.f };
+    
+    SimpleMBComp::GainReductionRange tileReduction;
+    bool hasTileReduction { false };
+    
 };
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+    
+    DirtyValue.h
+    Created: 16 Oct 2026 4:18:53pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace SimpleMBComp
+{
+/*
+ remembers the last value handed to a setter.
+ update() returns true only when the value differs from that one,
+ so expensive setters run when a parameter moves instead of every block.
+ */
+template<typename T>
+struct DirtyValue
+{
+    bool update(T newValue)
+    {
+        if( hasValue && newValue == value )
+            return false;
+        
+        value = newValue;
+        hasValue = true;
+        return true;
+    }
+    
+    //the next update() returns true whatever its value is
+    void invalidate() { hasValue = false; }
+    
+    T get() const { return value; }
+private:
+    T value {};
+    bool hasValue = false;
+};
+} //end namespace SimpleMBComp
@@ -60,7 +60,7 @@ struct Fifo
         auto write = fifo.write(1);
         if( write.blockSize1 > 0 )
         {
-            buffers[static_cast<size_t>(write.startIndex1)] = t;
+            copy(t, buffers[static_cast<size_t>(write.startIndex1)]);
             return true;
         }
         
@@ -72,7 +72,7 @@ struct Fifo
         auto read = fifo.read(1);
         if( read.blockSize1 > 0 )
         {
-            t = buffers[static_cast<size_t>(read.startIndex1)];
+            copy(buffers[static_cast<size_t>(read.startIndex1)], t);
             return true;
         }
         
@@ -138,6 +138,27 @@ struct Fifo
 private:
     std::array<T, Size> buffers;
     juce::AbstractFifo fifo {Size};
+    
+    /*
+     copy-assigning an AudioBuffer of a different size reallocates it.
+     push() runs on the audio thread, so reuse whatever storage 'dest' already has.
+     prepare() makes sure that storage is big enough for everything that gets pushed.
+     */
+    static void copy(const T& source, T& dest)
+    {
+        if constexpr( std::is_same_v<T, juce::AudioBuffer<float>> )
+        {
+            dest.makeCopyOf(source, true);
+        }
+        else if constexpr( std::is_same_v<T, std::vector<float>> )
+        {
+            dest.assign(source.begin(), source.end());
+        }
+        else
+        {
+            dest = source;
+        }
+    }
 };
 
 } //end namespace SimpleMBComp
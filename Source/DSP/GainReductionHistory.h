@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+    
+    GainReductionHistory.h
+    Created: 17 Oct 2026 11:02:37am
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Fifo.h"
+#include "Params.h"
+
+namespace SimpleMBComp
+{
+/*
+ the least and most gain reduction (dB, >= 0) applied over some stretch of samples.
+ */
+struct GainReductionRange
+{
+    float minDb { 0.f };
+    float maxDb { 0.f };
+    
+    void merge(const GainReductionRange& other)
+    {
+        minDb = juce::jmin(minDb, other.minDb);
+        maxDb = juce::jmax(maxDb, other.maxDb);
+    }
+};
+
+/*
+ every band's gain reduction range over the same few ms.
+ in mid/side mode 'bands' are the mid and 'sideBands' the side.
+ */
+struct GainReductionPoint
+{
+    std::array<GainReductionRange, Params::MAX_BANDS> bands, sideBands;
+    size_t numBands { 0 };
+    bool isMidSide { false };
+};
+
+/*
+ about 5 ms per point.  the fifo holds well over half a second of them,
+ so the editor can miss a few timer ticks without losing any.
+ */
+static constexpr double GAIN_REDUCTION_POINTS_PER_SECOND = 200.0;
+static constexpr size_t GAIN_REDUCTION_FIFO_SIZE = 256;
+
+using GainReductionFifo = Fifo<GainReductionPoint, GAIN_REDUCTION_FIFO_SIZE>;
+
+/*
+ merges the tiles' gain reduction into points of a fixed length and pushes each finished point to a fifo.
+ audio thread only.  push() never waits, when the fifo is full the point is dropped.
+ */
+struct GainReductionDecimator
+{
+    void prepare(double sampleRate)
+    {
+        samplesPerPoint = static_cast<size_t>(juce::jmax(1.0, std::round(sampleRate / GAIN_REDUCTION_POINTS_PER_SECOND)));
+        reset();
+    }
+    
+    void reset()
+    {
+        point = {};
+        numSamplesInPoint = 0;
+    }
+    
+    /*
+     'tile' covers the last 'numSamples' host rate samples.
+     a point ends at the first tile boundary after samplesPerPoint samples.
+     */
+    void add(const GainReductionPoint& tile, size_t numSamples, GainReductionFifo& fifo)
+    {
+        if( numSamplesInPoint == 0 || tile.numBands != point.numBands || tile.isMidSide != point.isMidSide )
+        {
+            point = tile;
+        }
+        else
+        {
+            for( size_t i = 0; i < tile.numBands; ++i )
+            {
+                point.bands[i].merge(tile.bands[i]);
+                point.sideBands[i].merge(tile.sideBands[i]);
+            }
+        }
+        
+        numSamplesInPoint += numSamples;
+        if( numSamplesInPoint >= samplesPerPoint )
+        {
+            fifo.push(point);
+            numSamplesInPoint = 0;
+        }
+    }
+private:
+    GainReductionPoint point;
+    size_t samplesPerPoint { 1 };
+    size_t numSamplesInPoint { 0 };
+};
+} //end namespace SimpleMBComp
@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+    
+    KernelBodies.h
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+/*
+ no #pragma once on purpose.
+ every Kernels<Isa>.cpp includes this once, inside its own namespace and compiled for its own target,
+ so every variant is built from the same source.
+ 
+ only plain loops and the C math functions in here.  anything inline from JUCE or the standard library
+ could be compiled for AVX-512 in one variant and then picked by the linker for all of them.
+ */
+
+#if ! defined(SIMPLEMBCOMP_KERNEL_VARIANT) || ! defined(SIMPLEMBCOMP_KERNEL_ISA)
+ #error "define SIMPLEMBCOMP_KERNEL_VARIANT and SIMPLEMBCOMP_KERNEL_ISA before including KernelBodies.h"
+#endif
+
+namespace SimpleMBComp
+{
+namespace Kernels
+{
+namespace SIMPLEMBCOMP_KERNEL_VARIANT
+{
+//the same comparisons as juce::jmax, juce::jmin and juce::jlimit
+template<typename T>
+T maxOf(T a, T b) { return a < b ? b : a; }
+
+template<typename T>
+T minOf(T a, T b) { return b < a ? b : a; }
+
+template<typename T>
+T limit(T lower, T upper, T value) { return value < lower ? lower : (upper < value ? upper : value); }
+
+template<typename T>
+T absOf(T x) { return x < T(0) ? -x : x; }
+
+template<typename T>
+T log10Of(T x)
+{
+    if constexpr( std::is_same_v<T, float> )
+        return ::log10f(x);
+    else
+        return ::log10(x);
+}
+
+template<typename T>
+T expOf(T x)
+{
+    if constexpr( std::is_same_v<T, float> )
+        return ::expf(x);
+    else
+        return ::exp(x);
+}
+
+//10^(-dB/20)
+template<typename T>
+T reductionToGainOf(T reductionDb)
+{
+    return expOf(reductionDb * static_cast<T>(-0.11512925464970228));
+}
+
+template<typename T>
+struct SectionCoefficients
+{
+    T g, R2, h, R2plusG;
+};
+
+/*
+ lanes [0, numLanes) through both sections.
+ a split vector can end in allpass or padding lanes, their low and high select are 0.
+ the pointers are parameters so the compiler can rely on __restrict.
+ */
+template<typename T>
+void runSplitLanes(const T* __restrict in, T* __restrict out, size_t numLanes,
+                   T* __restrict s1, T* __restrict s2, T* __restrict s3, T* __restrict s4,
+                   const T* __restrict low, const T* __restrict high, const T* __restrict all,
+                   SectionCoefficients<T> c)
+{
+    for( size_t l = 0; l < numLanes; ++l )
+    {
+        auto yH = (in[l] - s1[l] * c.R2plusG - s2[l]) * c.h;
+        
+        auto yB = yH * c.g + s1[l];
+        s1[l] = yH * c.g + yB;
+        
+        auto yL = yB * c.g + s2[l];
+        s2[l] = yB * c.g + yL;
+        
+        auto yH2 = (yL * low[l] + yH * high[l] - s3[l] * c.R2plusG - s4[l]) * c.h;
+        
+        auto yB2 = yH2 * c.g + s3[l];
+        s3[l] = yH2 * c.g + yB2;
+        
+        auto yL2 = yB2 * c.g + s4[l];
+        s4[l] = yB2 * c.g + yL2;
+        
+        out[l] = (yL - yB * c.R2 + yH) * all[l] + yL2 * low[l] + yH2 * high[l];
+    }
+}
+
+//lanes [0, numLanes) through the first section only
+template<typename T>
+void runAllpassLanes(const T* __restrict in, T* __restrict out, size_t numLanes,
+                     T* __restrict s1, T* __restrict s2, const T* __restrict all,
+                     SectionCoefficients<T> c)
+{
+    for( size_t l = 0; l < numLanes; ++l )
+    {
+        auto yH = (in[l] - s1[l] * c.R2plusG - s2[l]) * c.h;
+        
+        auto yB = yH * c.g + s1[l];
+        s1[l] = yH * c.g + yB;
+        
+        auto yL = yB * c.g + s2[l];
+        s2[l] = yB * c.g + yL;
+        
+        out[l] = (yL - yB * c.R2 + yH) * all[l];
+    }
+}
+
+template<typename T>
+void measureLanes(const T* __restrict out, T* __restrict peaks, T* __restrict sumsOfSquares, size_t numLanes)
+{
+    for( size_t l = 0; l < numLanes; ++l )
+    {
+        peaks[l] = maxOf(peaks[l], absOf(out[l]));
+        sumsOfSquares[l] += out[l] * out[l];
+    }
+}
+
+/*
+ the split lanes run both sections, the allpass lanes after them only the first.
+ */
+template<typename T>
+void crossoverPass(const CrossoverPass<T>& pass)
+{
+    const auto c = SectionCoefficients<T> { pass.g, pass.R2, pass.h, pass.R2 + pass.g };
+    const auto half = static_cast<T>(0.5);
+    const auto split = pass.numSplitLanes;
+    const auto numAllpassLanes = pass.numLanes - split;
+    
+    auto* in = pass.lanesIn;
+    auto* out = pass.lanesOut;
+    
+    for( size_t i = 0; i < pass.numSamples; ++i )
+    {
+        if( pass.encodeMidSide )
+        {
+            //the first pass has no allpasses, only the lowpass and highpass of both channels
+            auto left = pass.readPointers[0][i];
+            auto right = pass.readPointers[1][i];
+            in[0] = in[2] = (left + right) * half;
+            in[1] = in[3] = (left - right) * half;
+        }
+        else
+        {
+            for( size_t v = 0; v < pass.numVoices; ++v )
+                in[v] = pass.readPointers[v][i];
+        }
+        
+        runSplitLanes(in, out, split,
+                      pass.s1, pass.s2, pass.s3, pass.s4,
+                      pass.lowSelect, pass.highSelect, pass.allpassSelect,
+                      c);
+        
+        runAllpassLanes(in + split, out + split, numAllpassLanes,
+                        pass.s1 + split, pass.s2 + split, pass.allpassSelect + split,
+                        c);
+        
+        if( pass.peaks != nullptr )
+            measureLanes(out, pass.peaks, pass.sumsOfSquares, pass.numLanes);
+        
+        for( size_t v = 0; v < pass.numVoices; ++v )
+            pass.writePointers[v][i] = out[v];
+    }
+}
+
+/*
+ below T - W/2 nothing happens, above T + W/2 the level is reduced by 'slope' dB per dB,
+ in between the reduction fades in quadratically.
+ no sample depends on another, so this vectorizes over samples.
+ */
+template<typename T>
+void computeReduction(const T* __restrict input, T* __restrict reduction, size_t numSamples, const CompressorCurve<T>& curve)
+{
+    const auto thresholdDb = curve.thresholdDb;
+    const auto kneeDb = curve.kneeDb;
+    const auto slope = curve.reductionSlope;
+    const auto minLevel = curve.minLevel;
+    const auto halfKnee = kneeDb * static_cast<T>(0.5);
+    const auto kneeScale = kneeDb > static_cast<T>(0) ? static_cast<T>(0.5) / kneeDb : static_cast<T>(0);
+    
+    for( size_t i = 0; i < numSamples; ++i )
+    {
+        auto levelDb = static_cast<T>(20) * log10Of(maxOf(absOf(input[i]), minLevel));
+        auto over = levelDb - thresholdDb;
+        auto inKnee = limit(static_cast<T>(0), kneeDb, over + halfKnee);
+        auto aboveKnee = maxOf(static_cast<T>(0), over - halfKnee);
+        
+        reduction[i] = slope * (inKnee * inKnee * kneeScale + aboveKnee);
+    }
+}
+
+/*
+ one sample at a time with every channel in its own lane.
+ rising reduction moves by attackStep of the distance, falling reduction by releaseStep.
+ */
+template<typename T>
+void smoothReduction(T* const* rows, size_t numChannels, size_t numSamples,
+                     T* __restrict envelope, T* __restrict lanes, size_t numLanes,
+                     T attackStep, T releaseStep)
+{
+    const auto zero = static_cast<T>(0);
+    
+    for( size_t i = 0; i < numSamples; ++i )
+    {
+        for( size_t ch = 0; ch < numChannels; ++ch )
+            lanes[ch] = rows[ch][i];
+        
+        for( size_t l = 0; l < numLanes; ++l )
+        {
+            auto distance = lanes[l] - envelope[l];
+            envelope[l] = envelope[l] + maxOf(distance, zero) * attackStep
+                                      + minOf(distance, zero) * releaseStep;
+            lanes[l] = envelope[l];
+        }
+        
+        for( size_t ch = 0; ch < numChannels; ++ch )
+            rows[ch][i] = lanes[ch];
+    }
+}
+
+template<typename T>
+void reductionToGain(const T* __restrict reduction, T* __restrict gains, size_t numSamples)
+{
+    for( size_t i = 0; i < numSamples; ++i )
+        gains[i] = reductionToGainOf(reduction[i]);
+}
+
+template<typename T>
+void applyReduction(const T* __restrict reduction, const T* input, T* output, size_t numSamples)
+{
+    for( size_t i = 0; i < numSamples; ++i )
+        output[i] = input[i] * reductionToGainOf(reduction[i]);
+}
+
+/*
+ the peak and sum of squares are kept in 8 partial results,
+ so the compiler can keep them in vector registers instead of one long dependency chain.
+ every variant adds them up in the same order.
+ */
+static constexpr size_t NumPartials = 8;
+
+template<typename T>
+struct Partials
+{
+    T peaks[NumPartials] = {};
+    T squares[NumPartials] = {};
+    
+    void add(size_t k, T x)
+    {
+        peaks[k] = maxOf(peaks[k], absOf(x));
+        squares[k] += x * x;
+    }
+    
+    SampleLevels<T> sum() const
+    {
+        SampleLevels<T> levels;
+        for( size_t k = 0; k < NumPartials; ++k )
+        {
+            levels.peak = maxOf(levels.peak, peaks[k]);
+            levels.sumOfSquares += squares[k];
+        }
+        
+        return levels;
+    }
+};
+
+template<typename T>
+SampleLevels<T> copyAndMeasure(T* __restrict dest, const T* __restrict source, size_t numSamples, bool overwrite)
+{
+    Partials<T> partials;
+    
+    size_t i = 0;
+    for( ; i + NumPartials <= numSamples; i += NumPartials )
+    {
+        for( size_t k = 0; k < NumPartials; ++k )
+        {
+            auto x = source[i + k];
+            dest[i + k] = overwrite ? x : dest[i + k] + x;
+            partials.add(k, x);
+        }
+    }
+    
+    for( ; i < numSamples; ++i )
+    {
+        auto x = source[i];
+        dest[i] = overwrite ? x : dest[i] + x;
+        partials.add(0, x);
+    }
+    
+    return partials.sum();
+}
+
+template<typename T>
+void addMidSideSample(T* __restrict left, T* __restrict right, T mid, T side, size_t i, bool overwrite)
+{
+    left[i] = (overwrite ? mid : left[i] + mid) + side;
+    right[i] = (overwrite ? mid : right[i] + mid) - side;
+}
+
+template<typename T>
+void addMidSide(T* __restrict left, T* __restrict right, const T* __restrict mid, const T* __restrict side,
+                size_t numSamples, bool overwrite,
+                SampleLevels<T>& midLevels, SampleLevels<T>& sideLevels)
+{
+    Partials<T> midPartials, sidePartials;
+    
+    size_t i = 0;
+    for( ; i + NumPartials <= numSamples; i += NumPartials )
+    {
+        for( size_t k = 0; k < NumPartials; ++k )
+        {
+            addMidSideSample(left, right, mid[i + k], side[i + k], i + k, overwrite);
+            midPartials.add(k, mid[i + k]);
+            sidePartials.add(k, side[i + k]);
+        }
+    }
+    
+    for( ; i < numSamples; ++i )
+    {
+        addMidSideSample(left, right, mid[i], side[i], i, overwrite);
+        midPartials.add(0, mid[i]);
+        sidePartials.add(0, side[i]);
+    }
+    
+    midLevels = midPartials.sum();
+    sideLevels = sidePartials.sum();
+}
+
+/*
+ x - x is 0 for every finite x and NaN for infinities and NaNs,
+ which checks both without calling anything.
+ */
+inline void magnitudesToDecibels(float* __restrict data, size_t numBins, float divisor, float floorDb)
+{
+    for( size_t i = 0; i < numBins; ++i )
+    {
+        auto v = data[i];
+        v = v - v == 0.f ? v / divisor : 0.f;
+        
+        //the same as juce::Decibels::gainToDecibels(v, floorDb)
+        data[i] = v > 0.f ? maxOf(floorDb, log10Of(v) * 20.f) : floorDb;
+    }
+}
+
+template<typename T>
+constexpr KernelTable<T> makeTable()
+{
+    return { crossoverPass<T>,
+             computeReduction<T>,
+             smoothReduction<T>,
+             reductionToGain<T>,
+             applyReduction<T>,
+             copyAndMeasure<T>,
+             addMidSide<T> };
+}
+
+const KernelSet kernels { SIMPLEMBCOMP_KERNEL_ISA, makeTable<float>(), makeTable<double>(), magnitudesToDecibels };
+} //end namespace SIMPLEMBCOMP_KERNEL_VARIANT
+} //end namespace Kernels
+} //end namespace SimpleMBComp
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+    
+    Kernels.cpp
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "Kernels.h"
+
+namespace SimpleMBComp
+{
+namespace Kernels
+{
+namespace
+{
+bool canRun(Isa isa)
+{
+    switch( isa )
+    {
+        case Isa::Generic: return true;
+        //the AVX2 variant is also compiled with FMA, every AVX2 CPU so far has both
+        case Isa::AVX2: return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+        case Isa::AVX512: return juce::SystemStats::hasAVX512F();
+    }
+    
+    jassertfalse;
+    return false;
+}
+
+const KernelSet& pickKernels()
+{
+    auto forced = juce::SystemStats::getEnvironmentVariable("SIMPLEMBCOMP_ISA", {});
+    if( forced.isNotEmpty() )
+    {
+        for( auto isa : { Isa::Generic, Isa::AVX2, Isa::AVX512 } )
+        {
+            if( forced.equalsIgnoreCase(getName(isa)) )
+            {
+                if( auto* kernels = getKernels(isa) )
+                    return *kernels;
+            }
+        }
+    }
+    
+    //an unknown or unsupported forced variant falls back to the best one instead of failing
+    for( auto isa : { Isa::AVX512, Isa::AVX2 } )
+    {
+        if( auto* kernels = getKernels(isa) )
+            return *kernels;
+    }
+    
+    return *getGenericKernels();
+}
+
+std::atomic<const KernelSet*>& getActive()
+{
+    static std::atomic<const KernelSet*> active { &pickKernels() };
+    return active;
+}
+}
+
+const char* getName(Isa isa)
+{
+    switch( isa )
+    {
+        case Isa::Generic: return "generic";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512";
+    }
+    
+    jassertfalse;
+    return "";
+}
+
+const KernelSet* getKernels(Isa isa)
+{
+    const KernelSet* kernels = nullptr;
+    switch( isa )
+    {
+        case Isa::Generic: kernels = getGenericKernels(); break;
+        case Isa::AVX2: kernels = getAVX2Kernels(); break;
+        case Isa::AVX512: kernels = getAVX512Kernels(); break;
+    }
+    
+    return kernels != nullptr && canRun(isa) ? kernels : nullptr;
+}
+
+const KernelSet& getActiveKernels()
+{
+    return *getActive().load(std::memory_order_relaxed);
+}
+
+bool setActiveIsa(Isa isa)
+{
+    auto* kernels = getKernels(isa);
+    if( kernels == nullptr )
+        return false;
+    
+    getActive().store(kernels, std::memory_order_relaxed);
+    return true;
+}
+} //end namespace Kernels
+} //end namespace SimpleMBComp
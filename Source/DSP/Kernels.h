@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+    
+    Kernels.h
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+ deliberately nothing from JUCE in here.
+ the AVX2 and AVX-512 translation units include this before switching the compiler to their target,
+ and nothing inline they include may end up compiled for that target.
+ */
+#include <cstddef>
+#include <type_traits>
+
+namespace SimpleMBComp
+{
+namespace Kernels
+{
+/*
+ the instruction sets the hot DSP loops are compiled for.
+ every variant runs the same source, the wider ones let the compiler use wider registers.
+ */
+enum class Isa
+{
+    Generic,
+    AVX2,
+    AVX512,
+};
+
+const char* getName(Isa isa);
+
+/*
+ one pass of LinkwitzRileyFilterBank, every (filter, channel) pair in its own lane.
+ every per-lane array is numLanes long, numVoices rounded up to whole SIMD registers.
+ */
+template<typename SampleType>
+struct CrossoverPass
+{
+    //one per voice: the lowpasses, the highpasses, then the allpasses
+    const SampleType* const* readPointers = nullptr;
+    SampleType* const* writePointers = nullptr;
+    
+    size_t numSamples = 0, numVoices = 0, numLanes = 0;
+    
+    //lanes [0, numSplitLanes) also run the second lowpass/highpass section
+    size_t numSplitLanes = 0;
+    
+    SampleType g = 0, R2 = 0, h = 0;
+    
+    //first section state of every lane, second section state of the split lanes
+    SampleType* s1 = nullptr;
+    SampleType* s2 = nullptr;
+    SampleType* s3 = nullptr;
+    SampleType* s4 = nullptr;
+    
+    //0 or 1 per lane
+    const SampleType* lowSelect = nullptr;
+    const SampleType* highSelect = nullptr;
+    const SampleType* allpassSelect = nullptr;
+    
+    SampleType* lanesIn = nullptr;
+    SampleType* lanesOut = nullptr;
+    
+    //when not nullptr, every lane's peak and sum of squares are accumulated into these
+    SampleType* peaks = nullptr;
+    SampleType* sumsOfSquares = nullptr;
+    
+    //reads voices 0 and 1 as left and right and splits (L + R) / 2 and (L - R) / 2 instead
+    bool encodeMidSide = false;
+};
+
+/*
+ the static curve of the log domain compressor
+ */
+template<typename SampleType>
+struct CompressorCurve
+{
+    SampleType thresholdDb = 0, kneeDb = 0, reductionSlope = 0;
+    
+    //anything quieter is treated as this level, so silence doesn't take the log of 0
+    SampleType minLevel = 0;
+};
+
+template<typename SampleType>
+struct SampleLevels
+{
+    SampleType peak = 0, sumOfSquares = 0;
+};
+
+template<typename SampleType>
+struct KernelTable
+{
+    void (*crossoverPass)(const CrossoverPass<SampleType>& pass);
+    
+    //the gain reduction in dB of every sample of one channel, not smoothed yet
+    void (*computeReduction)(const SampleType* input, SampleType* reduction, size_t numSamples, const CompressorCurve<SampleType>& curve);
+    
+    /*
+     runs the attack/release envelope over 'rows' in place, one lane per channel.
+     'envelope' and 'lanes' are numLanes long, 'lanes' is scratch space.
+     */
+    void (*smoothReduction)(SampleType* const* rows, size_t numChannels, size_t numSamples,
+                            SampleType* envelope, SampleType* lanes, size_t numLanes,
+                            SampleType attackStep, SampleType releaseStep);
+    
+    //10^(-reduction / 20)
+    void (*reductionToGain)(const SampleType* reduction, SampleType* gains, size_t numSamples);
+    
+    //input * 10^(-reduction / 20).  'input' and 'output' may be the same
+    void (*applyReduction)(const SampleType* reduction, const SampleType* input, SampleType* output, size_t numSamples);
+    
+    //copies or adds 'source' to 'dest' and measures 'source' in the same pass
+    SampleLevels<SampleType> (*copyAndMeasure)(SampleType* dest, const SampleType* source, size_t numSamples, bool overwrite);
+    
+    //L = M + S and R = M - S, written over or added to left and right, mid and side measured in the same pass
+    void (*addMidSide)(SampleType* left, SampleType* right, const SampleType* mid, const SampleType* side,
+                       size_t numSamples, bool overwrite,
+                       SampleLevels<SampleType>& midLevels, SampleLevels<SampleType>& sideLevels);
+};
+
+struct KernelSet
+{
+    Isa isa;
+    KernelTable<float> floats;
+    KernelTable<double> doubles;
+    
+    /*
+     the analyzer's FFT magnitudes divided by 'divisor' and converted to dB, never below 'floorDb'.
+     non-finite magnitudes count as silence.
+     */
+    void (*magnitudesToDecibels)(float* data, size_t numBins, float divisor, float floorDb);
+    
+    template<typename SampleType>
+    const KernelTable<SampleType>& get() const
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubles;
+        else
+            return floats;
+    }
+};
+
+/*
+ the variants compiled into this build.
+ nullptr for a variant this architecture has no instructions for.
+ */
+const KernelSet* getGenericKernels();
+const KernelSet* getAVX2Kernels();
+const KernelSet* getAVX512Kernels();
+
+//nullptr unless 'isa' is compiled in and this CPU can run it
+const KernelSet* getKernels(Isa isa);
+
+/*
+ what every kernel call runs.
+ picked by CPUID the first time it is asked for: the widest variant this CPU supports.
+ SIMPLEMBCOMP_ISA=generic, avx2 or avx512 in the environment picks a variant instead.
+ the processor asks for it in its constructor, so the first call never happens on the audio thread.
+ */
+const KernelSet& getActiveKernels();
+
+template<typename SampleType>
+const KernelTable<SampleType>& getActiveTable()
+{
+    return getActiveKernels().get<SampleType>();
+}
+
+/*
+ switches every kernel call to 'isa', for testing and benchmarking.
+ returns false and changes nothing if this CPU can't run it.
+ */
+bool setActiveIsa(Isa isa);
+} //end namespace Kernels
+} //end namespace SimpleMBComp
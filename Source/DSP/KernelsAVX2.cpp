@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    
+    KernelsAVX2.cpp
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Kernels.h"
+
+#include <math.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define SIMPLEMBCOMP_HAS_AVX2_KERNELS 1
+#else
+ #define SIMPLEMBCOMP_HAS_AVX2_KERNELS 0
+#endif
+
+#if SIMPLEMBCOMP_HAS_AVX2_KERNELS
+/*
+ everything defined from here on is compiled for AVX2, whatever the project targets.
+ MSVC has no pragma for that, the avx2 compiler flag scheme gives this file /arch:AVX2 instead.
+ */
+ #if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+ #elif defined(__GNUC__)
+  #pragma GCC push_options
+  #pragma GCC target("avx2,fma")
+ #endif
+
+ #define SIMPLEMBCOMP_KERNEL_VARIANT avx2
+ #define SIMPLEMBCOMP_KERNEL_ISA Isa::AVX2
+ #include "KernelBodies.h"
+ #undef SIMPLEMBCOMP_KERNEL_VARIANT
+ #undef SIMPLEMBCOMP_KERNEL_ISA
+
+ #if defined(__clang__)
+  #pragma clang attribute pop
+ #elif defined(__GNUC__)
+  #pragma GCC pop_options
+ #endif
+#endif
+
+namespace SimpleMBComp
+{
+namespace Kernels
+{
+const KernelSet* getAVX2Kernels()
+{
+   #if SIMPLEMBCOMP_HAS_AVX2_KERNELS
+    return &avx2::kernels;
+   #else
+    return nullptr;
+   #endif
+}
+} //end namespace Kernels
+} //end namespace SimpleMBComp
@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+    
+    KernelsGeneric.cpp
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Kernels.h"
+
+#include <math.h>
+
+//whatever the project targets by default, SSE2 on x64 and NEON on arm64
+#define SIMPLEMBCOMP_KERNEL_VARIANT generic
+#define SIMPLEMBCOMP_KERNEL_ISA Isa::Generic
+#include "KernelBodies.h"
+#undef SIMPLEMBCOMP_KERNEL_VARIANT
+#undef SIMPLEMBCOMP_KERNEL_ISA
+
+namespace SimpleMBComp
+{
+namespace Kernels
+{
+const KernelSet* getGenericKernels()
+{
+    return &generic::kernels;
+}
+} //end namespace Kernels
+} //end namespace SimpleMBComp
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+    
+    LaneVector.h
+    Created: 16 Oct 2026 7:02:15pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace SimpleMBComp
+{
+/*
+ one SIMD register of samples, or a single sample when SIMD is unavailable.
+ the DSP loops that run independent voices (channels, filters) side by side put one voice per lane.
+ */
+#if JUCE_USE_SIMD
+template<typename SampleType>
+using LaneVectorOf = juce::dsp::SIMDRegister<SampleType>;
+#else
+template<typename SampleType>
+using LaneVectorOf = SampleType;
+#endif
+
+template<typename SampleType>
+static constexpr size_t lanesPerVector = sizeof(LaneVectorOf<SampleType>) / sizeof(SampleType);
+
+template<typename SampleType>
+size_t getNumLaneVectors(size_t numVoices)
+{
+    return (numVoices + lanesPerVector<SampleType> - 1) / lanesPerVector<SampleType>;
+}
+
+template<typename Vector>
+Vector laneMax(const Vector& a, const Vector& b)
+{
+    if constexpr( std::is_floating_point_v<Vector> )
+        return juce::jmax(a, b);
+    else
+        return Vector::max(a, b);
+}
+
+template<typename Vector>
+Vector laneMin(const Vector& a, const Vector& b)
+{
+    if constexpr( std::is_floating_point_v<Vector> )
+        return juce::jmin(a, b);
+    else
+        return Vector::min(a, b);
+}
+} //end namespace SimpleMBComp
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+    
+    LevelMeter.h
+    Created: 17 Oct 2026 9:24:51am
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../GUI/Utilities.h"
+#include "Kernels.h"
+#include "Params.h"
+
+namespace SimpleMBComp
+{
+/*
+ the peak and sum of squares of a run of samples, across however many channels.
+ the passes that split and sum the bands fill these in while they touch the samples anyway,
+ nothing reads a band a second time just to meter it.
+ */
+struct LevelAccumulator
+{
+    float peak { 0.f };
+    float sumOfSquares { 0.f };
+    size_t numValues { 0 };
+    
+    void add(float peakToAdd, float sumOfSquaresToAdd, size_t numValuesToAdd)
+    {
+        peak = juce::jmax(peak, peakToAdd);
+        sumOfSquares += sumOfSquaresToAdd;
+        numValues += numValuesToAdd;
+    }
+    
+    void add(const LevelAccumulator& other) { add(other.peak, other.sumOfSquares, other.numValues); }
+    
+    void reset() { *this = {}; }
+    
+    float getPeakDb() const { return juce::Decibels::gainToDecibels(peak, NEG_INFINITY); }
+    
+    float getRmsDb() const
+    {
+        if( numValues == 0 )
+            return NEG_INFINITY;
+        
+        return juce::Decibels::gainToDecibels(std::sqrt(sumOfSquares / static_cast<float>(numValues)), NEG_INFINITY);
+    }
+};
+
+/*
+ accumulates 'source' into 'levels' while copying or adding it to 'dest', in one pass.
+ */
+template<typename SampleType>
+void copyAndMeasure(SampleType* dest, const SampleType* source, size_t numSamples, bool overwrite, LevelAccumulator& levels)
+{
+    const auto measured = Kernels::getActiveTable<SampleType>().copyAndMeasure(dest, source, numSamples, overwrite);
+    levels.add(static_cast<float>(measured.peak), static_cast<float>(measured.sumOfSquares), numSamples);
+}
+
+/*
+ one band's levels over one host block, in dB.
+ the gain reduction is the most the compressor applied, >= 0.
+ */
+struct BandLevels
+{
+    float inputPeakDb { NEG_INFINITY };
+    float inputRmsDb { NEG_INFINITY };
+    float outputPeakDb { NEG_INFINITY };
+    float outputRmsDb { NEG_INFINITY };
+    float gainReductionDb { 0.f };
+};
+
+/*
+ every band's levels from the same host block.
+ the audio thread hands these to the editor whole, so it never sees one band's levels from one block
+ next to another band's from the next.
+ in mid/side mode 'bands' are the mid and 'sideBands' the side.
+ */
+struct MeterFrame
+{
+    std::array<BandLevels, Params::MAX_BANDS> bands, sideBands;
+    size_t numBands { 0 };
+    bool isMidSide { false };
+};
+} //end namespace SimpleMBComp
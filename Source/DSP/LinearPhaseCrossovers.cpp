@@ -0,0 +1,434 @@
+/*
+  ==============================================================================
+    
+    LinearPhaseCrossovers.cpp
+    Created: 16 Oct 2026 9:48:12pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "LinearPhaseCrossovers.h"
+
+namespace SimpleMBComp
+{
+/*
+ half the kernel length, rounded up to a power of two.
+ at 48 kHz that is 8191 taps, which resolves crossovers down to roughly 30 Hz.
+ */
+static constexpr double KERNEL_HALF_LENGTH_SECONDS = 0.08;
+
+static size_t getHalfLength(double sampleRate)
+{
+    return static_cast<size_t>(juce::nextPowerOfTwo(juce::roundToInt(sampleRate * KERNEL_HALF_LENGTH_SECONDS)));
+}
+
+LinearPhaseCrossovers::LinearPhaseCrossovers() : juce::Thread("Linear Phase Kernels")
+{
+}
+
+LinearPhaseCrossovers::~LinearPhaseCrossovers()
+{
+    stopDesigner();
+}
+
+void LinearPhaseCrossovers::stopDesigner()
+{
+    signalThreadShouldExit();
+    designRequested.post();
+    stopThread(1000);
+}
+
+void LinearPhaseCrossovers::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    prepared.store(false, std::memory_order_release);
+    stopDesigner();
+    
+    sampleRate = spec.sampleRate;
+    numChannels = spec.numChannels;
+    halfLength = getHalfLength(sampleRate);
+    numPartitions = halfLength * 2 / PARTITION_SIZE;
+    
+    for( auto& kernels : kernelSets )
+    {
+        kernels.spectra.assign(Params::MAX_BANDS * numPartitions * SPECTRUM_SIZE, 0.f);
+        kernels.numBands = 0;
+    }
+    
+    front = 0;
+    middle.store(1);
+    back = 2;
+    
+    lowpass.assign(halfLength * 2 - 1, 0.0);
+    previousLowpass.assign(halfLength * 2 - 1, 0.0);
+    bandKernel.assign(numPartitions * PARTITION_SIZE, 0.f);
+    designBuffer.assign(FFT_SIZE * 2, 0.f);
+    
+    inputBuffers.assign(numChannels * FFT_SIZE, 0.f);
+    inputSpectra.assign(numChannels * numPartitions * SPECTRUM_SIZE, 0.f);
+    outputBuffers.assign(Params::MAX_BANDS * numChannels * PARTITION_SIZE, 0.f);
+    accumulator.assign(SPECTRUM_SIZE, 0.f);
+    fadeBuffer.assign(PARTITION_SIZE, 0.f);
+    fftBuffer.assign(FFT_SIZE * 2, 0.f);
+    bandPeaks.assign(Params::MAX_BANDS * numChannels, 0.f);
+    bandSumsOfSquares.assign(bandPeaks.size(), 0.f);
+    
+    //the first blocks are processed with the current crossovers, not with whatever the designer gets to first
+    designedVersion = requestVersion.load();
+    designKernels(kernelSets[static_cast<size_t>(front)]);
+    
+    clear();
+    
+    prepared.store(true, std::memory_order_release);
+    startThread(juce::Thread::Priority::low);
+    
+    //a request posted while the kernels above were designed was not seen yet
+    designRequested.post();
+}
+
+void LinearPhaseCrossovers::release()
+{
+    prepared.store(false, std::memory_order_release);
+    stopDesigner();
+    
+    for( auto* buffer : { &lowpass, &previousLowpass } )
+        std::vector<double>().swap(*buffer);
+    
+    for( auto* buffer : { &bandKernel, &designBuffer, &inputBuffers, &inputSpectra, &outputBuffers,
+                          &accumulator, &fadeBuffer, &fftBuffer, &bandPeaks, &bandSumsOfSquares } )
+        std::vector<float>().swap(*buffer);
+    
+    for( auto& kernels : kernelSets )
+    {
+        std::vector<float>().swap(kernels.spectra);
+        kernels.numBands = 0;
+    }
+}
+
+void LinearPhaseCrossovers::reset()
+{
+    if( isPrepared() )
+        clear();
+}
+
+void LinearPhaseCrossovers::clear()
+{
+    std::fill(inputBuffers.begin(), inputBuffers.end(), 0.f);
+    std::fill(inputSpectra.begin(), inputSpectra.end(), 0.f);
+    std::fill(outputBuffers.begin(), outputBuffers.end(), 0.f);
+    
+    spectrumPosition = 0;
+    partitionPosition = 0;
+    numBandsProcessed = 0;
+}
+
+void LinearPhaseCrossovers::setCrossovers(const std::array<float, Params::MAX_CROSSOVERS>& frequencies, size_t numBands)
+{
+    if( frequencies == lastFrequencies && numBands == lastNumBands )
+        return;
+    
+    lastFrequencies = frequencies;
+    lastNumBands = numBands;
+    
+    for( size_t i = 0; i < frequencies.size(); ++i )
+        requestedFrequencies[i].store(frequencies[i]);
+    
+    requestedNumBands.store(numBands);
+    
+    //published last, so the designer never sees the new version with the old frequencies
+    requestVersion.fetch_add(1, std::memory_order_release);
+    
+    //before prepare() nobody is listening, prepare() picks the request up itself
+    if( isPrepared() )
+        designRequested.post();
+}
+
+int LinearPhaseCrossovers::getLatencyInSamples() const
+{
+    return static_cast<int>(halfLength - 1 + PARTITION_SIZE);
+}
+
+int LinearPhaseCrossovers::getLatencyInSamples(double sampleRate)
+{
+    return static_cast<int>(getHalfLength(sampleRate) - 1 + PARTITION_SIZE);
+}
+
+//==============================================================================
+void LinearPhaseCrossovers::run()
+{
+    /*
+     a semaphore instead of juce::Thread::notify() keeps the audio thread away from the mutex behind it.
+     several requests posted while one set is designed are all answered by the next one.
+     */
+    for( ;; )
+    {
+        designRequested.wait();
+        if( threadShouldExit() )
+            return;
+        
+        auto version = requestVersion.load(std::memory_order_acquire);
+        if( version != designedVersion )
+        {
+            designedVersion = version;
+            designKernels(kernelSets[static_cast<size_t>(back)]);
+            back = middle.exchange(back | NEW_KERNELS, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+    }
+}
+
+void LinearPhaseCrossovers::computeLowpass(std::vector<double>& kernel, double cutoff) const
+{
+    //blackman windowed sinc, normalised to unity gain at DC
+    const auto normalisedCutoff = juce::jlimit(1.0, sampleRate * 0.49, cutoff) / sampleRate;
+    const auto centre = static_cast<double>(halfLength - 1);
+    const auto windowLength = static_cast<double>(kernel.size() - 1);
+    
+    auto sum = 0.0;
+    for( size_t n = 0; n < kernel.size(); ++n )
+    {
+        auto x = static_cast<double>(n) - centre;
+        auto sinc = x == 0.0 ? 2.0 * normalisedCutoff
+                             : std::sin(juce::MathConstants<double>::twoPi * normalisedCutoff * x) / (juce::MathConstants<double>::pi * x);
+        
+        auto phase = juce::MathConstants<double>::twoPi * static_cast<double>(n) / windowLength;
+        auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        
+        kernel[n] = sinc * window;
+        sum += kernel[n];
+    }
+    
+    for( auto& tap : kernel )
+        tap /= sum;
+}
+
+void LinearPhaseCrossovers::designKernels(KernelSet& kernels)
+{
+    const auto numBands = requestedNumBands.load();
+    jassert(numBands <= Params::MAX_BANDS);
+    
+    /*
+     band b = lowpass(b) - lowpass(b - 1), with lowpass(-1) = 0 and lowpass(numBands - 1) = a unit impulse.
+     the sum telescopes to the impulse, so the bands always sum flat.
+     */
+    std::fill(previousLowpass.begin(), previousLowpass.end(), 0.0);
+    for( size_t band = 0; band < numBands; ++band )
+    {
+        if( band + 1 < numBands )
+        {
+            computeLowpass(lowpass, static_cast<double>(requestedFrequencies[band].load()));
+        }
+        else
+        {
+            std::fill(lowpass.begin(), lowpass.end(), 0.0);
+            lowpass[halfLength - 1] = 1.0;
+        }
+        
+        for( size_t n = 0; n < lowpass.size(); ++n )
+            bandKernel[n] = static_cast<float>(lowpass[n] - previousLowpass[n]);
+        
+        std::swap(lowpass, previousLowpass);
+        
+        for( size_t partition = 0; partition < numPartitions; ++partition )
+        {
+            std::fill(designBuffer.begin(), designBuffer.end(), 0.f);
+            std::copy_n(bandKernel.begin() + static_cast<std::ptrdiff_t>(partition * PARTITION_SIZE),
+                        PARTITION_SIZE,
+                        designBuffer.begin());
+            
+            designerFFT.performRealOnlyForwardTransform(designBuffer.data(), true);
+            std::copy_n(designBuffer.begin(), SPECTRUM_SIZE, kernels.getPartition(band, partition, numPartitions));
+        }
+    }
+    
+    kernels.numBands = numBands;
+}
+
+//==============================================================================
+template<typename SampleType>
+void LinearPhaseCrossovers::process(const juce::dsp::AudioBlock<const SampleType>& input,
+                                    juce::dsp::AudioBlock<SampleType>* bands,
+                                    size_t numBands,
+                                    bool encodeMidSide)
+{
+    const auto numSamples = input.getNumSamples();
+    jassert(input.getNumChannels() <= numChannels);
+    jassert(numBands <= Params::MAX_BANDS);
+    jassert(! encodeMidSide || input.getNumChannels() == 2);
+    
+    jassert(isPrepared());
+    
+    std::fill(bandPeaks.begin(), bandPeaks.end(), 0.f);
+    std::fill(bandSumsOfSquares.begin(), bandSumsOfSquares.end(), 0.f);
+    numSamplesMeasured = numSamples;
+    
+    //bands that just came into use still hold what they were left with the last time they were
+    for( auto band = numBandsProcessed; band < numBands; ++band )
+        std::fill_n(getOutputBuffer(band, 0), numChannels * PARTITION_SIZE, 0.f);
+    
+    numBandsProcessed = numBands;
+    
+    size_t done = 0;
+    while( done < numSamples )
+    {
+        auto numToCopy = juce::jmin(numSamples - done, PARTITION_SIZE - partitionPosition);
+        
+        if( encodeMidSide )
+        {
+            auto* left = input.getChannelPointer(0) + done;
+            auto* right = input.getChannelPointer(1) + done;
+            auto* mid = getInputBuffer(0) + PARTITION_SIZE + partitionPosition;
+            auto* side = getInputBuffer(1) + PARTITION_SIZE + partitionPosition;
+            for( size_t i = 0; i < numToCopy; ++i )
+            {
+                mid[i] = static_cast<float>((left[i] + right[i]) * static_cast<SampleType>(0.5));
+                side[i] = static_cast<float>((left[i] - right[i]) * static_cast<SampleType>(0.5));
+            }
+        }
+        
+        for( size_t ch = 0; ch < input.getNumChannels(); ++ch )
+        {
+            if( ! encodeMidSide )
+            {
+                auto* source = input.getChannelPointer(ch) + done;
+                auto* dest = getInputBuffer(ch) + PARTITION_SIZE + partitionPosition;
+                for( size_t i = 0; i < numToCopy; ++i )
+                    dest[i] = static_cast<float>(source[i]);
+            }
+            
+            //the bands are measured as they are copied out
+            for( size_t band = 0; band < numBands; ++band )
+            {
+                auto* output = getOutputBuffer(band, ch) + partitionPosition;
+                auto* bandSamples = bands[band].getChannelPointer(ch) + done;
+                auto peak = 0.f;
+                auto sumOfSquares = 0.f;
+                for( size_t i = 0; i < numToCopy; ++i )
+                {
+                    auto x = output[i];
+                    bandSamples[i] = static_cast<SampleType>(x);
+                    peak = juce::jmax(peak, std::abs(x));
+                    sumOfSquares += x * x;
+                }
+                
+                auto index = band * numChannels + ch;
+                bandPeaks[index] = juce::jmax(bandPeaks[index], peak);
+                bandSumsOfSquares[index] += sumOfSquares;
+            }
+        }
+        
+        partitionPosition += numToCopy;
+        done += numToCopy;
+        
+        if( partitionPosition == PARTITION_SIZE )
+        {
+            processPartition(numBands);
+            partitionPosition = 0;
+        }
+    }
+}
+
+template void LinearPhaseCrossovers::process<float>(const juce::dsp::AudioBlock<const float>&, juce::dsp::AudioBlock<float>*, size_t, bool);
+template void LinearPhaseCrossovers::process<double>(const juce::dsp::AudioBlock<const double>&, juce::dsp::AudioBlock<double>*, size_t, bool);
+
+LevelAccumulator LinearPhaseCrossovers::getLevels(size_t band, size_t firstChannel, size_t count) const
+{
+    jassert(band < Params::MAX_BANDS && firstChannel + count <= numChannels);
+    
+    LevelAccumulator levels;
+    for( auto ch = firstChannel; ch < firstChannel + count; ++ch )
+        levels.add(bandPeaks[band * numChannels + ch], bandSumsOfSquares[band * numChannels + ch], numSamplesMeasured);
+    
+    return levels;
+}
+
+void LinearPhaseCrossovers::processPartition(size_t numBands)
+{
+    for( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto* inputBuffer = getInputBuffer(ch);
+        
+        std::copy_n(inputBuffer, FFT_SIZE, fftBuffer.begin());
+        fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+        std::copy_n(fftBuffer.begin(), SPECTRUM_SIZE, getInputSpectrum(ch, spectrumPosition));
+        
+        //the partition just filled is the previous one next time
+        std::copy_n(inputBuffer + PARTITION_SIZE, PARTITION_SIZE, inputBuffer);
+    }
+    
+    /*
+     new kernels are faded in against the old ones.
+     the old set is only handed back to the designer once this partition is done with it.
+     */
+    if( (middle.load(std::memory_order_acquire) & NEW_KERNELS) == 0 )
+    {
+        for( size_t band = 0; band < numBands; ++band )
+            for( size_t ch = 0; ch < numChannels; ++ch )
+                convolve(kernelSets[static_cast<size_t>(front)], band, numBands, ch, getOutputBuffer(band, ch));
+    }
+    else
+    {
+        for( size_t band = 0; band < numBands; ++band )
+            for( size_t ch = 0; ch < numChannels; ++ch )
+                convolve(kernelSets[static_cast<size_t>(front)], band, numBands, ch, getOutputBuffer(band, ch));
+        
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        
+        const auto fadeStep = 1.f / static_cast<float>(PARTITION_SIZE);
+        for( size_t band = 0; band < numBands; ++band )
+        {
+            for( size_t ch = 0; ch < numChannels; ++ch )
+            {
+                auto* output = getOutputBuffer(band, ch);
+                convolve(kernelSets[static_cast<size_t>(front)], band, numBands, ch, fadeBuffer.data());
+                
+                for( size_t i = 0; i < PARTITION_SIZE; ++i )
+                    output[i] += (fadeBuffer[i] - output[i]) * static_cast<float>(i + 1) * fadeStep;
+            }
+        }
+    }
+    
+    spectrumPosition = (spectrumPosition + 1) % numPartitions;
+}
+
+void LinearPhaseCrossovers::convolve(KernelSet& kernels, size_t band, size_t numBands, size_t channel, float* output)
+{
+    /*
+     until the kernels for a new band count arrive the old ones are used, and they still have to sum flat.
+     a set designed for fewer bands leaves the bands above it silent.
+     a set designed for more folds the kernels above the top band in use into it.
+     */
+    if( band >= kernels.numBands )
+    {
+        std::fill_n(output, PARTITION_SIZE, 0.f);
+        return;
+    }
+    
+    const auto lastKernel = band + 1 == numBands ? kernels.numBands : band + 1;
+    
+    std::fill(accumulator.begin(), accumulator.end(), 0.f);
+    auto* acc = accumulator.data();
+    
+    //partition p of the kernel meets the input from p partitions ago
+    for( auto kernel = band; kernel < lastKernel; ++kernel )
+    {
+        for( size_t partition = 0; partition < numPartitions; ++partition )
+        {
+            auto slot = (spectrumPosition + numPartitions - partition) % numPartitions;
+            const auto* x = getInputSpectrum(channel, slot);
+            const auto* h = kernels.getPartition(kernel, partition, numPartitions);
+            
+            for( size_t bin = 0; bin < SPECTRUM_SIZE; bin += 2 )
+            {
+                acc[bin]     += x[bin] * h[bin]     - x[bin + 1] * h[bin + 1];
+                acc[bin + 1] += x[bin] * h[bin + 1] + x[bin + 1] * h[bin];
+            }
+        }
+    }
+    
+    std::copy(accumulator.begin(), accumulator.end(), fftBuffer.begin());
+    fft.performRealOnlyInverseTransform(fftBuffer.data());
+    
+    //the first half is circular wrap-around, only the second half is valid
+    std::copy_n(fftBuffer.begin() + PARTITION_SIZE, PARTITION_SIZE, output);
+}
+} //end namespace SimpleMBComp
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+    
+    LinearPhaseCrossovers.h
+    Created: 16 Oct 2026 9:48:12pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LevelMeter.h"
+#include "Params.h"
+#include "Semaphore.h"
+
+namespace SimpleMBComp
+{
+/*
+ the linear-phase alternative to LinkwitzRileyFilterBank, for mastering.
+ 
+ band b is the input convolved with lowpass(crossover b) - lowpass(crossover b - 1),
+ so the bands always sum back to the input delayed by getLatencyInSamples().
+ 
+ the convolution is uniformly partitioned overlap-save: every PARTITION_SIZE samples
+ one forward FFT per channel and one inverse FFT per band and channel are run,
+ whatever block size the host uses.
+ 
+ kernels are designed on a background thread whenever the crossovers change and
+ handed to the audio thread through a triple buffer, so the audio thread never waits
+ or allocates. old and new kernels are crossfaded over one partition.
+ until they arrive the old ones keep summing flat, see convolve().
+ 
+ nothing is allocated and no thread runs until prepare(), so an instance that never
+ uses linear phase doesn't pay for it.
+ 
+ the FFTs are single precision, double precision blocks are converted on the way in and out.
+ */
+struct LinearPhaseCrossovers : private juce::Thread
+{
+    static constexpr int FFT_ORDER = 9;
+    static constexpr size_t FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr size_t PARTITION_SIZE = FFT_SIZE / 2;
+    
+    LinearPhaseCrossovers();
+    ~LinearPhaseCrossovers() override;
+    
+    /*
+     stops the designer, allocates everything for MAX_BANDS bands, designs kernels for
+     the last crossovers passed to setCrossovers() and starts the designer again.
+     never call it from the audio thread.  it may run while the audio thread is busy with
+     something else, as long as that only calls setCrossovers() and reset() until isPrepared().
+     */
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    bool isPrepared() const { return prepared.load(std::memory_order_acquire); }
+    
+    //stops the designer and frees everything prepare() allocated
+    void release();
+    
+    //does nothing before prepare()
+    void reset();
+    
+    /*
+     called from the audio thread. only records the request and wakes the designer thread,
+     which picks it up.
+     */
+    void setCrossovers(const std::array<float, Params::MAX_CROSSOVERS>& frequencies, size_t numBands);
+    
+    /*
+     the kernels' group delay plus one partition of buffering.
+     the static one is what prepare() will end up with at 'sampleRate'.
+     */
+    int getLatencyInSamples() const;
+    static int getLatencyInSamples(double sampleRate);
+    
+    /*
+     writes bands[0] ... bands[numBands - 1].
+     the bands must not alias 'input'.
+     with 'encodeMidSide' a stereo input is encoded to mid and side on its way into the input buffers.
+     */
+    template<typename SampleType>
+    void process(const juce::dsp::AudioBlock<const SampleType>& input,
+                 juce::dsp::AudioBlock<SampleType>* bands,
+                 size_t numBands,
+                 bool encodeMidSide = false);
+    
+    /*
+     the levels of what the last process() wrote to channels [firstChannel, firstChannel + count) of 'band',
+     measured while the bands are copied out of the output buffers.
+     */
+    LevelAccumulator getLevels(size_t band, size_t firstChannel, size_t count) const;
+private:
+    static constexpr size_t NUM_BINS = PARTITION_SIZE + 1;
+    //interleaved real and imaginary parts
+    static constexpr size_t SPECTRUM_SIZE = NUM_BINS * 2;
+    
+    //one each for the audio thread and the designer
+    juce::dsp::FFT fft { FFT_ORDER }, designerFFT { FFT_ORDER };
+    
+    double sampleRate { 0.0 };
+    size_t numChannels { 0 };
+    //kernels are 2 * halfLength - 1 taps long, centred on tap halfLength - 1
+    size_t halfLength { 0 };
+    size_t numPartitions { 0 };
+    
+    /*
+     the frequency domain partitions of every band's kernel.
+     partition p of band b starts at spectra[(b * numPartitions + p) * SPECTRUM_SIZE]
+     */
+    struct KernelSet
+    {
+        std::vector<float> spectra;
+        size_t numBands { 0 };
+        
+        float* getPartition(size_t band, size_t partition, size_t numPartitions)
+        {
+            return spectra.data() + (band * numPartitions + partition) * SPECTRUM_SIZE;
+        }
+    };
+    
+    /*
+     the designer fills kernelSets[back], then swaps it with 'middle'.
+     the audio thread swaps 'front' with 'middle' when NEW_KERNELS is set.
+     each side only ever touches the set it owns.
+     */
+    std::array<KernelSet, 3> kernelSets;
+    static constexpr int NEW_KERNELS = 4;
+    static constexpr int INDEX_MASK = 3;
+    std::atomic<int> middle { 1 };
+    int front { 0 };
+    int back { 2 };
+    
+    //the request, written by the audio thread and read by the designer
+    std::array<std::atomic<float>, Params::MAX_CROSSOVERS> requestedFrequencies {};
+    std::atomic<size_t> requestedNumBands { 0 };
+    std::atomic<juce::uint32> requestVersion { 0 };
+    juce::uint32 designedVersion { 0 };
+    
+    //posted whenever there is a new request, the designer sleeps on it otherwise
+    Semaphore designRequested;
+    std::atomic<bool> prepared { false };
+    
+    //the audio thread's copy of the last request, so an unchanged one isn't posted again
+    std::array<float, Params::MAX_CROSSOVERS> lastFrequencies {};
+    size_t lastNumBands { 0 };
+    
+    //designer scratch
+    std::vector<double> lowpass, previousLowpass;
+    std::vector<float> bandKernel, designBuffer;
+    
+    void run() override;
+    void stopDesigner();
+    void designKernels(KernelSet& kernels);
+    void computeLowpass(std::vector<double>& kernel, double cutoff) const;
+    
+    /*
+     audio thread state.
+     inputBuffers hold the previous partition followed by the one being filled,
+     inputSpectra are the spectra of the last numPartitions input partitions, newest at spectrumPosition.
+     */
+    std::vector<float> inputBuffers, inputSpectra, outputBuffers;
+    std::vector<float> accumulator, fadeBuffer, fftBuffer;
+    std::vector<float> bandPeaks, bandSumsOfSquares;
+    size_t numSamplesMeasured { 0 };
+    size_t spectrumPosition { 0 };
+    size_t partitionPosition { 0 };
+    
+    //the bands the last process() wrote, the output buffers of any above them are stale
+    size_t numBandsProcessed { 0 };
+    
+    void clear();
+    
+    float* getInputBuffer(size_t channel) { return inputBuffers.data() + channel * FFT_SIZE; }
+    float* getInputSpectrum(size_t channel, size_t slot) { return inputSpectra.data() + (channel * numPartitions + slot) * SPECTRUM_SIZE; }
+    float* getOutputBuffer(size_t band, size_t channel) { return outputBuffers.data() + (band * numChannels + channel) * PARTITION_SIZE; }
+    
+    void processPartition(size_t numBands);
+    void convolve(KernelSet& kernels, size_t band, size_t numBands, size_t channel, float* output);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinearPhaseCrossovers)
+};
+} //end namespace SimpleMBComp
@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+    
+    LinkwitzRileyFilterBank.h
+    Created: 16 Oct 2026 2:41:17pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Kernels.h"
+#include "LaneVector.h"
+#include "LevelMeter.h"
+
+namespace SimpleMBComp
+{
+/*
+ the crossover network of an N band compressor, built from the same 4th order
+ Linkwitz-Riley sections juce::dsp::LinkwitzRileyFilter uses.
+ 
+ every filter that shares a cutoff frequency is run in one pass, with every
+ (filter, channel) pair in its own SIMD lane:
+     - the lowpass and highpass that split the remainder at crossover X.
+       their first section sees the same input with the same coefficients.
+       both lanes still compute it side by side, the lowpass and highpass
+       outputs are only picked apart by the selects of the second section.
+     - the allpasses that phase-align bands 0...X-1 with crossover X.
+ 
+ the lanes of pass X are laid out like this (C = numChannels):
+     [0, C)                 lowpass, reads the remainder, writes band X
+     [C, 2C)                highpass, reads the remainder, writes band X + 1
+     [2C + b * C, ...)      allpass on band b, in place
+ */
+template<typename SampleType, size_t NBands>
+struct LinkwitzRileyFilterBank
+{
+    static constexpr size_t NumCrossovers = NBands - 1;
+    
+    using BandBlocks = std::array<juce::dsp::AudioBlock<SampleType>, NBands>;
+    
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<size_t>(spec.numChannels);
+        
+        size_t maxVoices = 0;
+        for( size_t x = 0; x < passes.size(); ++x )
+        {
+            auto& pass = passes[x];
+            pass.numSplitVoices = 2 * numChannels;
+            pass.numVoices = pass.numSplitVoices + x * numChannels;
+            pass.numVectors = getNumVectors(pass.numVoices);
+            pass.numSplitVectors = getNumVectors(pass.numSplitVoices);
+            
+            pass.s1.assign(pass.numVectors, Lanes());
+            pass.s2.assign(pass.numVectors, Lanes());
+            pass.s3.assign(pass.numSplitVectors, Lanes());
+            pass.s4.assign(pass.numSplitVectors, Lanes());
+            
+            /*
+             0 or 1 per lane.  multiplying by these picks the lowpass,
+             highpass or allpass result without branching per lane.
+             */
+            std::vector<SampleType> low(pass.numVectors * LanesPerVector, 0);
+            std::vector<SampleType> high(low.size(), 0);
+            std::vector<SampleType> all(low.size(), 0);
+            for( size_t v = 0; v < pass.numVoices; ++v )
+            {
+                if( v < numChannels )
+                    low[v] = 1;
+                else if( v < pass.numSplitVoices )
+                    high[v] = 1;
+                else
+                    all[v] = 1;
+            }
+            
+            pass.lowSelect = toVectors(low);
+            pass.highSelect = toVectors(high);
+            pass.allpassSelect = toVectors(all);
+            
+            pass.coefficients.update(pass.cutoff, sampleRate);
+            
+            maxVoices = juce::jmax(maxVoices, pass.numVoices);
+        }
+        
+        lanesIn.assign(getNumVectors(maxVoices), Lanes());
+        lanesOut.assign(lanesIn.size(), Lanes());
+        
+        peaks.assign(passes.back().numVectors, Lanes());
+        sumsOfSquares.assign(peaks.size(), Lanes());
+        
+        readPointers.assign(maxVoices, nullptr);
+        writePointers.assign(maxVoices, nullptr);
+    }
+    
+    void reset()
+    {
+        for( auto& pass : passes )
+        {
+            for( auto* state : { &pass.s1, &pass.s2, &pass.s3, &pass.s4 } )
+                std::fill(state->begin(), state->end(), Lanes());
+        }
+    }
+    
+    //the coefficients are only recomputed when 'newCutoff' differs from the current cutoff
+    void setCutoffFrequency(size_t crossover, float newCutoff)
+    {
+        jassert(juce::isPositiveAndBelow(newCutoff, static_cast<float>(sampleRate * 0.5)));
+        
+        auto& pass = passes[crossover];
+        if( newCutoff == pass.cutoff )
+            return;
+        
+        pass.cutoff = newCutoff;
+        pass.coefficients.update(newCutoff, sampleRate);
+    }
+    
+    float getCutoffFrequency(size_t crossover) const { return passes[crossover].cutoff; }
+    
+    /*
+     takes over every cutoff of 'other' without recomputing the coefficients.
+     both banks have to run at the same sample rate.
+     */
+    void copyCoefficientsFrom(const LinkwitzRileyFilterBank& other)
+    {
+        jassert(other.sampleRate == sampleRate);
+        
+        for( size_t x = 0; x < passes.size(); ++x )
+        {
+            passes[x].cutoff = other.passes[x].cutoff;
+            passes[x].coefficients = other.passes[x].coefficients;
+        }
+    }
+    
+    /*
+     splits 'input' into 'bands'.
+     'input' may not alias any of 'bands'.
+     
+     with 'encodeMidSide' a stereo input is split as mid (L + R) / 2 and side (L - R) / 2,
+     encoded while the first crossover reads it instead of in a pass of its own.
+     */
+    void process(const juce::dsp::AudioBlock<const SampleType>& input, BandBlocks& bands, bool encodeMidSide = false)
+    {
+        const auto numSamples = input.getNumSamples();
+        jassert(input.getNumChannels() == numChannels);
+        jassert(! encodeMidSide || numChannels == 2);
+        
+        std::fill(peaks.begin(), peaks.end(), Lanes());
+        std::fill(sumsOfSquares.begin(), sumsOfSquares.end(), Lanes());
+        numSamplesMeasured = numSamples;
+        
+        for( size_t x = 0; x < passes.size(); ++x )
+        {
+            auto& pass = passes[x];
+            
+            for( size_t ch = 0; ch < numChannels; ++ch )
+            {
+                /*
+                 the first crossover reads the input.
+                 every crossover after that reads what the previous highpass left in bands[x].
+                 */
+                readPointers[ch] = x == 0 ? input.getChannelPointer(ch) : bands[x].getChannelPointer(ch);
+                readPointers[numChannels + ch] = readPointers[ch];
+                
+                writePointers[ch] = bands[x].getChannelPointer(ch);
+                writePointers[numChannels + ch] = bands[x + 1].getChannelPointer(ch);
+                
+                for( size_t b = 0; b < x; ++b )
+                {
+                    auto voice = pass.numSplitVoices + b * numChannels + ch;
+                    writePointers[voice] = bands[b].getChannelPointer(ch);
+                    readPointers[voice] = writePointers[voice];
+                }
+            }
+            
+            processPass(pass, numSamples, encodeMidSide && x == 0, x + 1 == passes.size());
+        }
+    }
+    
+    /*
+     the levels of what the last process() wrote to channels [firstChannel, firstChannel + count) of 'band'.
+     the last pass writes the final samples of every band, so it measures them on the way out.
+     */
+    LevelAccumulator getLevels(size_t band, size_t firstChannel, size_t count) const
+    {
+        jassert(band < NBands && firstChannel + count <= numChannels);
+        
+        //the lanes of the last pass: lowpass, highpass, then the allpasses of the bands below
+        auto firstVoice = band + 2 == NBands ? 0
+                        : band + 1 == NBands ? numChannels
+                        : 2 * numChannels + band * numChannels;
+        firstVoice += firstChannel;
+        
+        auto* peakLanes = reinterpret_cast<const SampleType*>(peaks.data());
+        auto* squareLanes = reinterpret_cast<const SampleType*>(sumsOfSquares.data());
+        
+        LevelAccumulator levels;
+        for( size_t v = firstVoice; v < firstVoice + count; ++v )
+            levels.add(static_cast<float>(peakLanes[v]), static_cast<float>(squareLanes[v]), numSamplesMeasured);
+        
+        return levels;
+    }
+private:
+    using Lanes = LaneVectorOf<SampleType>;
+    static constexpr size_t LanesPerVector = lanesPerVector<SampleType>;
+    
+    struct Coefficients
+    {
+        SampleType g = 0, R2 = 0, h = 0;
+        
+        //identical to juce::dsp::LinkwitzRileyFilter::update()
+        void update(float cutoff, double sr)
+        {
+            g  = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * cutoff / sr));
+            R2 = static_cast<SampleType>(std::sqrt(2.0));
+            h  = static_cast<SampleType>(1.0 / (1.0 + R2 * g + g * g));
+        }
+    };
+    
+    struct Pass
+    {
+        float cutoff = 1000.f;
+        Coefficients coefficients;
+        
+        size_t numVoices = 0, numSplitVoices = 0;
+        size_t numVectors = 0, numSplitVectors = 0;
+        
+        //first section state for every lane, second section state for the lowpass/highpass lanes.
+        std::vector<Lanes> s1, s2, s3, s4;
+        std::vector<Lanes> lowSelect, highSelect, allpassSelect;
+    };
+    
+    std::array<Pass, NumCrossovers> passes;
+    
+    double sampleRate = 44100.0;
+    size_t numChannels = 0;
+    
+    std::vector<Lanes> lanesIn, lanesOut;
+    
+    //per lane of the last pass, reset by every process()
+    std::vector<Lanes> peaks, sumsOfSquares;
+    size_t numSamplesMeasured = 0;
+    std::vector<const SampleType*> readPointers;
+    std::vector<SampleType*> writePointers;
+    
+    static size_t getNumVectors(size_t numVoices)
+    {
+        return getNumLaneVectors<SampleType>(numVoices);
+    }
+    
+    static std::vector<Lanes> toVectors(const std::vector<SampleType>& lanes)
+    {
+        std::vector<Lanes> vectors(lanes.size() / LanesPerVector, Lanes());
+        std::copy(lanes.begin(), lanes.end(), reinterpret_cast<SampleType*>(vectors.data()));
+        return vectors;
+    }
+    
+    //the loop itself is a dispatched kernel, compiled for every instruction set in KernelBodies.h
+    void processPass(Pass& pass, size_t numSamples, bool encodeMidSide, bool measure)
+    {
+        auto toLanes = [](auto& vectors) { return reinterpret_cast<SampleType*>(vectors.data()); };
+        auto toConstLanes = [](const auto& vectors) { return reinterpret_cast<const SampleType*>(vectors.data()); };
+        
+        Kernels::CrossoverPass<SampleType> kernelPass;
+        kernelPass.readPointers = readPointers.data();
+        kernelPass.writePointers = writePointers.data();
+        kernelPass.numSamples = numSamples;
+        kernelPass.numVoices = pass.numVoices;
+        kernelPass.numLanes = pass.numVectors * LanesPerVector;
+        kernelPass.numSplitLanes = pass.numSplitVectors * LanesPerVector;
+        kernelPass.g = pass.coefficients.g;
+        kernelPass.R2 = pass.coefficients.R2;
+        kernelPass.h = pass.coefficients.h;
+        kernelPass.s1 = toLanes(pass.s1);
+        kernelPass.s2 = toLanes(pass.s2);
+        kernelPass.s3 = toLanes(pass.s3);
+        kernelPass.s4 = toLanes(pass.s4);
+        kernelPass.lowSelect = toConstLanes(pass.lowSelect);
+        kernelPass.highSelect = toConstLanes(pass.highSelect);
+        kernelPass.allpassSelect = toConstLanes(pass.allpassSelect);
+        kernelPass.lanesIn = toLanes(lanesIn);
+        kernelPass.lanesOut = toLanes(lanesOut);
+        kernelPass.peaks = measure ? toLanes(peaks) : nullptr;
+        kernelPass.sumsOfSquares = measure ? toLanes(sumsOfSquares) : nullptr;
+        kernelPass.encodeMidSide = encodeMidSide;
+        
+        Kernels::getActiveTable<SampleType>().crossoverPass(kernelPass);
+        
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        for( auto* state : { &pass.s1, &pass.s2, &pass.s3, &pass.s4 } )
+        {
+            auto* lanes = reinterpret_cast<SampleType*>(state->data());
+            for( size_t l = 0; l < state->size() * LanesPerVector; ++l )
+                juce::dsp::util::snapToZero(lanes[l]);
+        }
+       #endif
+    }
+};
+} //end namespace SimpleMBComp
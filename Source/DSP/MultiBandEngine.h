@@ -0,0 +1,595 @@
+/*
+  ==============================================================================
+    
+    MultiBandEngine.h
+    Created: 16 Oct 2026 10:12:04am
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "BandWorkerPool.h"
+#include "CompressorBand.h"
+#include "LinearPhaseCrossovers.h"
+#include "LinkwitzRileyFilterBank.h"
+#include "Params.h"
+#include "ProcessingSnapshot.h"
+
+namespace SimpleMBComp
+{
+template<typename Func, size_t... Is>
+void forEachIndexImpl(Func&& func, std::index_sequence<Is...>)
+{
+    (func(std::integral_constant<size_t, Is>()), ...);
+    juce::ignoreUnused(func);
+}
+
+/*
+ calls func(std::integral_constant<size_t, i>()) for every i in [0, Count).
+ the calls are expanded at compile time, so there is no loop left to branch on.
+ */
+template<size_t Count, typename Func>
+void forEachIndex(Func&& func)
+{
+    forEachIndexImpl(std::forward<Func>(func), std::make_index_sequence<Count>());
+}
+
+/*
+ processBlock() runs every stage on one tile of at most this many samples
+ before moving on to the next one, so the working set of a tile stays in L1
+ whatever block size the host uses.
+ */
+static constexpr size_t TILE_SIZE = 64;
+
+/*
+ blocks at least this long are worth handing the bands to a BandWorkerPool.
+ they are processed this many samples at a time: every tile of the chunk is split first,
+ then the bands compress the whole chunk in parallel, then every tile is summed.
+ shorter blocks don't have enough work per band to pay for waking the workers.
+ */
+static constexpr size_t PARALLEL_CHUNK_SIZE = 2048;
+static constexpr size_t TILES_PER_CHUNK = PARALLEL_CHUNK_SIZE / TILE_SIZE;
+
+template<typename SampleType>
+using BandBuffersOf = std::array<juce::AudioBuffer<SampleType>, Params::MAX_BANDS>;
+
+/*
+ one set of band buffers per sample type, plus one for the bands of the sidechain key.
+ only the sets for the precision the host processes in are given any space,
+ the key sets only when there is a sidechain.
+ */
+struct BandBuffers
+{
+    BandBuffersOf<float> floats, floatKeys;
+    BandBuffersOf<double> doubles, doubleKeys;
+    
+    template<typename SampleType>
+    BandBuffersOf<SampleType>& get()
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubles;
+        else
+            return floats;
+    }
+    
+    template<typename SampleType>
+    BandBuffersOf<SampleType>& getKeys()
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleKeys;
+        else
+            return floatKeys;
+    }
+};
+
+/*
+ the processor holds one engine per band count and picks one per block.
+ everything that depends on the band count lives behind this interface.
+ */
+struct MultiBandEngineBase
+{
+    virtual ~MultiBandEngineBase() = default;
+    
+    virtual void prepare(const juce::dsp::ProcessSpec& spec) = 0;
+    virtual void reset() = 0;
+    
+    /*
+     with snapshot.linearPhase the bands come from the shared LinearPhaseCrossovers
+     instead of the engine's own Linkwitz-Riley filters.
+     with snapshot.midSide a stereo block is split as mid and side, the mid of every band goes to
+     its compressor and the side to its side compressor.  other blocks ignore it.
+     the solo, mute and sidechain switches are read from 'snapshot' by every block until the next call,
+     it has to stay alive until then.
+     */
+    virtual void updateState(const ProcessingSnapshot& snapshot) = 0;
+    /*
+     splits 'block' into bands, compresses them and sums the audible bands back into 'block'.
+     'block' is one tile, never longer than TILE_SIZE.
+     a non-empty 'key' is split the same way and drives the bands whose sidechain is on.
+     it has to be as long and as wide as 'block'.
+     */
+    virtual void process(juce::dsp::AudioBlock<float> block, juce::dsp::AudioBlock<const float> key) = 0;
+    virtual void process(juce::dsp::AudioBlock<double> block, juce::dsp::AudioBlock<const double> key) = 0;
+    
+    /*
+     the same for a chunk of up to PARALLEL_CHUNK_SIZE samples, with the bands compressed on 'pool'.
+     the band buffers have to be at least that long.
+     the output is the same as processing the chunk one tile at a time.
+     */
+    virtual void process(juce::dsp::AudioBlock<float> block, juce::dsp::AudioBlock<const float> key, BandWorkerPool& pool) = 0;
+    virtual void process(juce::dsp::AudioBlock<double> block, juce::dsp::AudioBlock<const double> key, BandWorkerPool& pool) = 0;
+    
+    virtual size_t getNumBands() const = 0;
+};
+
+template<size_t NBands>
+struct MultiBandEngine : MultiBandEngineBase
+{
+    static_assert(Params::MIN_BANDS <= NBands && NBands <= Params::MAX_BANDS,
+                  "MultiBandEngine only supports MIN_BANDS...MAX_BANDS bands");
+    
+    static constexpr size_t NumBands = NBands;
+    static constexpr size_t NumCrossovers = NBands - 1;
+    
+    MultiBandEngine(CompressorBands& comps, CompressorBands& sideComps, BandBuffers& buffers, LinearPhaseCrossovers& linearPhase) :
+    compressors(comps),
+    sideCompressors(sideComps),
+    filterBuffers(buffers),
+    linearPhaseCrossovers(linearPhase)
+    {
+    }
+    
+    //the filter state is small, so both precisions are always prepared
+    void prepare(const juce::dsp::ProcessSpec& spec) override
+    {
+        for( auto* bank : { &floatCrossovers, &floatKeyCrossovers } )
+            bank->prepare(spec);
+        
+        for( auto* bank : { &doubleCrossovers, &doubleKeyCrossovers } )
+            bank->prepare(spec);
+    }
+    
+    void reset() override
+    {
+        for( auto* bank : { &floatCrossovers, &floatKeyCrossovers } )
+            bank->reset();
+        
+        for( auto* bank : { &doubleCrossovers, &doubleKeyCrossovers } )
+            bank->reset();
+    }
+    
+    void updateState(const ProcessingSnapshot& snapshot) override
+    {
+        jassert(snapshot.numBands == NumBands);
+        
+        for( size_t i = 0; i < NumCrossovers; ++i )
+        {
+            floatCrossovers.setCutoffFrequency(i, snapshot.crossovers[i]);
+            doubleCrossovers.setCutoffFrequency(i, snapshot.crossovers[i]);
+        }
+        
+        floatKeyCrossovers.copyCoefficientsFrom(floatCrossovers);
+        doubleKeyCrossovers.copyCoefficientsFrom(doubleCrossovers);
+        
+        //kernels are only designed while they are being listened to
+        if( snapshot.linearPhase )
+            linearPhaseCrossovers.setCrossovers(snapshot.crossovers, NumBands);
+        
+        isLinearPhase = snapshot.linearPhase;
+        isMidSide = snapshot.midSide;
+        bandSettings = &snapshot.bands;
+        sideBandSettings = &snapshot.sideBands;
+    }
+    
+    void process(juce::dsp::AudioBlock<float> block, juce::dsp::AudioBlock<const float> key) override { processTile(block, key); }
+    void process(juce::dsp::AudioBlock<double> block, juce::dsp::AudioBlock<const double> key) override { processTile(block, key); }
+    void process(juce::dsp::AudioBlock<float> block, juce::dsp::AudioBlock<const float> key, BandWorkerPool& pool) override { processChunk(block, key, pool); }
+    void process(juce::dsp::AudioBlock<double> block, juce::dsp::AudioBlock<const double> key, BandWorkerPool& pool) override { processChunk(block, key, pool); }
+    
+    size_t getNumBands() const override { return NumBands; }
+private:
+    CompressorBands& compressors;
+    CompressorBands& sideCompressors;
+    BandBuffers& filterBuffers;
+    LinearPhaseCrossovers& linearPhaseCrossovers;
+    bool isLinearPhase { false };
+    bool isMidSide { false };
+    bool wasKeyed { false };
+    
+    using BandSettings = std::array<CompressorBand::Settings, Params::MAX_BANDS>;
+    const BandSettings* bandSettings { nullptr };
+    const BandSettings* sideBandSettings { nullptr };
+    
+    template<typename SampleType>
+    using BandBlocks = std::array<juce::dsp::AudioBlock<SampleType>, NumBands>;
+    
+    /*
+     band 0:        LP[0] -> AP[1] -> AP[2] ... -> AP[N-2]
+     band 1: HP[0]  LP[1] -> AP[2] ... -> AP[N-2]
+     ...
+     band N-1: HP[0] -> HP[1] ... -> HP[N-2]
+     */
+    LinkwitzRileyFilterBank<float, NumBands> floatCrossovers;
+    LinkwitzRileyFilterBank<double, NumBands> doubleCrossovers;
+    
+    /*
+     the same network for the sidechain key, sharing the coefficients of the one above.
+     the key is always split minimum phase, only the detectors listen to it.
+     */
+    LinkwitzRileyFilterBank<float, NumBands> floatKeyCrossovers;
+    LinkwitzRileyFilterBank<double, NumBands> doubleKeyCrossovers;
+    
+    template<typename SampleType>
+    auto& getCrossovers()
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleCrossovers;
+        else
+            return floatCrossovers;
+    }
+    
+    template<typename SampleType>
+    auto& getKeyCrossovers()
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleKeyCrossovers;
+        else
+            return floatKeyCrossovers;
+    }
+    
+    /*
+     the band buffers are sized to one tile or chunk in prepareToPlay() and never resized here,
+     we only ever look at the part of them this block needs.
+     */
+    template<typename SampleType>
+    static BandBlocks<SampleType> getBandBlocks(BandBuffersOf<SampleType>& buffers, size_t numChannels, size_t numSamples)
+    {
+        BandBlocks<SampleType> blocks;
+        for( size_t i = 0; i < NumBands; ++i )
+        {
+            auto& fb = buffers[i];
+            jassert(numChannels <= static_cast<size_t>(fb.getNumChannels()));
+            jassert(numSamples <= static_cast<size_t>(fb.getNumSamples()));
+            
+            blocks[i] = juce::dsp::AudioBlock<SampleType>(fb)
+                            .getSubsetChannelBlock(0, numChannels)
+                            .getSubBlock(0, numSamples);
+        }
+        
+        return blocks;
+    }
+    
+    template<typename SampleType>
+    static BandBlocks<SampleType> getTile(const BandBlocks<SampleType>& chunk, size_t start, size_t numSamples)
+    {
+        BandBlocks<SampleType> tile;
+        for( size_t i = 0; i < NumBands; ++i )
+            tile[i] = chunk[i].getSubBlock(start, numSamples);
+        
+        return tile;
+    }
+    
+    /*
+     L = M + S and R = M - S, written over or added to 'block'.
+     this is the only place mid/side is decoded, while the bands are summed,
+     and the mid and side are metered in the same pass.
+     */
+    template<typename SampleType>
+    static void addMidSide(juce::dsp::AudioBlock<SampleType>& block,
+                           const juce::dsp::AudioBlock<SampleType>& band,
+                           bool overwrite,
+                           LevelAccumulator& midLevels,
+                           LevelAccumulator& sideLevels)
+    {
+        const auto numSamples = block.getNumSamples();
+        Kernels::SampleLevels<SampleType> mid, side;
+        
+        Kernels::getActiveTable<SampleType>().addMidSide(block.getChannelPointer(0),
+                                                         block.getChannelPointer(1),
+                                                         band.getChannelPointer(0),
+                                                         band.getChannelPointer(1),
+                                                         numSamples,
+                                                         overwrite,
+                                                         mid,
+                                                         side);
+        
+        midLevels.add(static_cast<float>(mid.peak), static_cast<float>(mid.sumOfSquares), numSamples);
+        sideLevels.add(static_cast<float>(side.peak), static_cast<float>(side.sumOfSquares), numSamples);
+    }
+    
+    /*
+     the key is only split while a band listens to it.
+     when one starts listening again, the filters start from silence instead of the key's past.
+     */
+    template<typename SampleType>
+    bool updateKeyed(bool hasKey, bool midSide)
+    {
+        auto isKeyed = false;
+        if( hasKey )
+        {
+            forEachIndex<NumBands>([this, &isKeyed, midSide](auto band)
+            {
+                isKeyed |= (*bandSettings)[band].sidechain;
+                if( midSide )
+                    isKeyed |= (*sideBandSettings)[band].sidechain;
+            });
+        }
+        
+        if( isKeyed && ! wasKeyed )
+            getKeyCrossovers<SampleType>().reset();
+        
+        wasKeyed = isKeyed;
+        return isKeyed;
+    }
+    
+    bool areBandsSoloed(bool midSide) const
+    {
+        auto bandsAreSoloed = false;
+        forEachIndex<NumBands>([this, &bandsAreSoloed, midSide](auto band)
+        {
+            bandsAreSoloed |= (*bandSettings)[band].solo;
+            if( midSide )
+                bandsAreSoloed |= (*sideBandSettings)[band].solo;
+        });
+        
+        return bandsAreSoloed;
+    }
+    
+    /*
+     splits one tile of 'block' and 'key' into 'bands' and 'keys'.
+     in mid/side mode the bands hold mid in channel 0 and side in channel 1 from here on.
+     */
+    template<typename SampleType>
+    void splitTile(juce::dsp::AudioBlock<SampleType> block,
+                   juce::dsp::AudioBlock<const SampleType> key,
+                   BandBlocks<SampleType>& bands,
+                   BandBlocks<SampleType>& keys,
+                   bool isKeyed,
+                   bool midSide)
+    {
+        jassert(block.getNumSamples() <= TILE_SIZE);
+        
+        if( isLinearPhase )
+            linearPhaseCrossovers.process(juce::dsp::AudioBlock<const SampleType>(block), bands.data(), NumBands, midSide);
+        else
+            getCrossovers<SampleType>().process(block, bands, midSide);
+        
+        if( isKeyed )
+        {
+            jassert(key.getNumChannels() == block.getNumChannels() && key.getNumSamples() == block.getNumSamples());
+            getKeyCrossovers<SampleType>().process(key, keys, midSide);
+        }
+        
+        //the splitter measured the bands while it wrote them, those levels only last until the next tile
+        auto measure = [this](CompressorBand& comp, size_t band, size_t firstChannel, size_t count)
+        {
+            comp.inputLevels.add(isLinearPhase ? linearPhaseCrossovers.getLevels(band, firstChannel, count)
+                                               : getCrossovers<SampleType>().getLevels(band, firstChannel, count));
+        };
+        
+        const auto numChannels = block.getNumChannels();
+        for( size_t band = 0; band < NumBands; ++band )
+        {
+            if( midSide )
+            {
+                measure(compressors[band], band, 0, 1);
+                measure(sideCompressors[band], band, 1, 1);
+            }
+            else
+            {
+                measure(compressors[band], band, 0, numChannels);
+            }
+        }
+    }
+    
+    /*
+     compresses one tile of one band, 'keyTile' is empty unless the tile's key was split.
+     only touches this band's compressors, so different bands can run on different threads.
+     returns whether the tile has to be summed.
+     */
+    template<typename SampleType>
+    bool compressTile(size_t band,
+                      juce::dsp::AudioBlock<SampleType> tile,
+                      juce::dsp::AudioBlock<SampleType> keyTile,
+                      bool bandsAreSoloed,
+                      bool midSide)
+    {
+        /*
+         compresses channels [firstChannel, firstChannel + count) of 'tile' with 'comp'.
+         a band that finishes fading out during this tile still has to be summed,
+         so whether it is gets decided before it is processed.
+         */
+        auto compress = [&tile, &keyTile, bandsAreSoloed](CompressorBand& comp,
+                                                          const CompressorBand::Settings& settings,
+                                                          size_t firstChannel,
+                                                          size_t count)
+        {
+            comp.setAudible(bandsAreSoloed ? settings.solo : ! settings.mute);
+            auto isAudible = ! comp.isSilent();
+            
+            auto channels = tile.getSubsetChannelBlock(firstChannel, count);
+            if( keyTile.getNumChannels() > 0 && settings.sidechain )
+                comp.process(channels, keyTile.getSubsetChannelBlock(firstChannel, count));
+            else
+                comp.process(channels);
+            
+            return isAudible;
+        };
+        
+        if( ! midSide )
+            return compress(compressors[band], (*bandSettings)[band], 0, tile.getNumChannels());
+        
+        auto isMidSummed = compress(compressors[band], (*bandSettings)[band], 0, 1);
+        auto isSideSummed = compress(sideCompressors[band], (*sideBandSettings)[band], 1, 1);
+        
+        //a silent half still holds its uncompressed split
+        if( isMidSummed != isSideSummed )
+            tile.getSingleChannelBlock(isMidSummed ? 1 : 0).clear();
+        
+        return isMidSummed || isSideSummed;
+    }
+    
+    /*
+     the first summed band overwrites the tile, the rest are added to it.
+     every band's output is metered on its way in.
+     */
+    template<typename SampleType>
+    void sumTile(juce::dsp::AudioBlock<SampleType> block,
+                 const BandBlocks<SampleType>& bands,
+                 const std::array<bool, NumBands>& isSummed,
+                 bool midSide)
+    {
+        const auto numChannels = block.getNumChannels();
+        const auto numSamples = block.getNumSamples();
+        
+        auto outputIsEmpty = true;
+        forEachIndex<NumBands>([&](auto band)
+        {
+            if( ! isSummed[band] )
+                return;
+            
+            if( midSide )
+            {
+                addMidSide(block, bands[band], outputIsEmpty, compressors[band].outputLevels, sideCompressors[band].outputLevels);
+            }
+            else
+            {
+                for( size_t ch = 0; ch < numChannels; ++ch )
+                {
+                    copyAndMeasure(block.getChannelPointer(ch),
+                                   bands[band].getChannelPointer(ch),
+                                   numSamples,
+                                   outputIsEmpty,
+                                   compressors[band].outputLevels);
+                }
+            }
+            
+            outputIsEmpty = false;
+        });
+        
+        if( outputIsEmpty )
+            block.clear();
+    }
+    
+    template<typename SampleType>
+    void processTile(juce::dsp::AudioBlock<SampleType> block, juce::dsp::AudioBlock<const SampleType> key)
+    {
+        const auto numChannels = block.getNumChannels();
+        const auto numSamples = block.getNumSamples();
+        const auto midSide = isMidSide && numChannels == 2;
+        
+        auto bands = getBandBlocks(filterBuffers.get<SampleType>(), numChannels, numSamples);
+        
+        const auto isKeyed = updateKeyed<SampleType>(key.getNumChannels() > 0, midSide);
+        BandBlocks<SampleType> keys;
+        if( isKeyed )
+            keys = getBandBlocks(filterBuffers.getKeys<SampleType>(), numChannels, numSamples);
+        
+        splitTile(block, key, bands, keys, isKeyed, midSide);
+        
+        const auto bandsAreSoloed = areBandsSoloed(midSide);
+        std::array<bool, NumBands> isSummed {};
+        for( size_t band = 0; band < NumBands; ++band )
+            isSummed[band] = compressTile(band, bands[band], keys[band], bandsAreSoloed, midSide);
+        
+        sumTile(block, bands, isSummed, midSide);
+    }
+    
+    /*
+     the split and the sum run tile by tile on this thread, the filters and the summing are cheap
+     next to the compressors.  every band then compresses all of its tiles in order as one task,
+     so each compressor still sees exactly the tiles it would have seen one tile at a time.
+     */
+    template<typename SampleType>
+    void processChunk(juce::dsp::AudioBlock<SampleType> block, juce::dsp::AudioBlock<const SampleType> key, BandWorkerPool& pool)
+    {
+        const auto numChannels = block.getNumChannels();
+        const auto numSamples = block.getNumSamples();
+        const auto midSide = isMidSide && numChannels == 2;
+        const auto numTiles = (numSamples + TILE_SIZE - 1) / TILE_SIZE;
+        jassert(numTiles <= TILES_PER_CHUNK);
+        
+        auto bands = getBandBlocks(filterBuffers.get<SampleType>(), numChannels, numSamples);
+        
+        const auto isKeyed = updateKeyed<SampleType>(key.getNumChannels() > 0, midSide);
+        BandBlocks<SampleType> keys;
+        if( isKeyed )
+            keys = getBandBlocks(filterBuffers.getKeys<SampleType>(), numChannels, numSamples);
+        
+        auto getTileLength = [numSamples](size_t tile) { return juce::jmin(TILE_SIZE, numSamples - tile * TILE_SIZE); };
+        
+        for( size_t tile = 0; tile < numTiles; ++tile )
+        {
+            const auto start = tile * TILE_SIZE;
+            const auto length = getTileLength(tile);
+            auto tileBands = getTile(bands, start, length);
+            auto tileKeys = isKeyed ? getTile(keys, start, length) : BandBlocks<SampleType>();
+            splitTile(block.getSubBlock(start, length),
+                      isKeyed ? key.getSubBlock(start, length) : juce::dsp::AudioBlock<const SampleType>(),
+                      tileBands,
+                      tileKeys,
+                      isKeyed,
+                      midSide);
+        }
+        
+        const auto bandsAreSoloed = areBandsSoloed(midSide);
+        std::array<std::array<bool, NumBands>, TILES_PER_CHUNK> isSummed {};
+        
+        auto compressBand = [&](size_t band)
+        {
+            for( size_t tile = 0; tile < numTiles; ++tile )
+            {
+                const auto start = tile * TILE_SIZE;
+                const auto length = getTileLength(tile);
+                isSummed[tile][band] = compressTile(band,
+                                                    bands[band].getSubBlock(start, length),
+                                                    isKeyed ? keys[band].getSubBlock(start, length) : juce::dsp::AudioBlock<SampleType>(),
+                                                    bandsAreSoloed,
+                                                    midSide);
+            }
+        };
+        
+        pool.forEach(NumBands, compressBand);
+        
+        for( size_t tile = 0; tile < numTiles; ++tile )
+        {
+            const auto start = tile * TILE_SIZE;
+            const auto length = getTileLength(tile);
+            sumTile(block.getSubBlock(start, length), getTile(bands, start, length), isSummed[tile], midSide);
+        }
+    }
+};
+
+using MultiBandEngines = std::array<std::unique_ptr<MultiBandEngineBase>,
+                                    Params::MAX_BANDS - Params::MIN_BANDS + 1>;
+
+template<size_t... Is>
+MultiBandEngines createMultiBandEnginesImpl(CompressorBands& compressors,
+                                            CompressorBands& sideCompressors,
+                                            BandBuffers& buffers,
+                                            LinearPhaseCrossovers& linearPhase,
+                                            std::index_sequence<Is...>)
+{
+    return { std::make_unique<MultiBandEngine<Params::MIN_BANDS + Is>>(compressors, sideCompressors, buffers, linearPhase)... };
+}
+
+/*
+ creates one engine for every supported band count.
+ engines[numBands - MIN_BANDS] is the engine for 'numBands' bands
+ */
+inline MultiBandEngines createMultiBandEngines(CompressorBands& compressors,
+                                               CompressorBands& sideCompressors,
+                                               BandBuffers& buffers,
+                                               LinearPhaseCrossovers& linearPhase)
+{
+    return createMultiBandEnginesImpl(compressors,
+                                      sideCompressors,
+                                      buffers,
+                                      linearPhase,
+                                      std::make_index_sequence<Params::MAX_BANDS - Params::MIN_BANDS + 1>());
+}
+} //end namespace SimpleMBComp
@@ -9,3 +9,110 @@
 */
 
 #include "Params.h"
+
+namespace Params
+{
+const std::map<Names, juce::String>& GetParams()
+{
+    static std::map<Names, juce::String> params =
+    {
+        {Number_Of_Bands, "Number Of Bands"},
+        {Oversampling, "Oversampling"},
+        {Lookahead, "Lookahead"},
+        {Crossover_Mode, "Crossover Mode"},
+        {Stereo_Mode, "Stereo Mode"},
+        
+        {Gain_In,"Gain In"},
+        {Gain_Out,"Gain Out"},
+    };
+    
+    return params;
+}
+
+/*
+ the 3 band versions named their bands Low, Mid and High, i.e. "Attack Low Band".
+ sessions, presets and automation lanes saved back then refer to those IDs,
+ so the first three bands keep them for every setting that existed back then.
+ everything added since, and every band after the third, is numbered instead.
+ */
+static const std::array<juce::String, 3> LEGACY_BAND_NAMES { "Low", "Mid", "High" };
+static const std::array<BandNames, 7> LEGACY_BAND_SETTINGS { Threshold, Attack, Release, Ratio, Bypassed, Mute, Solo };
+
+//i.e. "Attack" + " Band " + "3"
+static std::array<std::map<BandNames, juce::String>, MAX_BANDS> makeBandParams(const juce::String& infix, bool keepLegacyNames)
+{
+    const std::map<BandNames, juce::String> prefixes
+    {
+        {Threshold, "Threshold"},
+        {Knee, "Knee"},
+        {Attack, "Attack"},
+        {Release, "Release"},
+        {Ratio, "Ratio"},
+        {Bypassed, "Bypassed"},
+        {Mute, "Mute"},
+        {Solo, "Solo"},
+        {Sidechain, "Sidechain"},
+    };
+        
+    std::array<std::map<BandNames, juce::String>, MAX_BANDS> names;
+    for( size_t band = 0; band < names.size(); ++band )
+    {
+        for( const auto& [name, prefix] : prefixes )
+        {
+            auto isLegacy = keepLegacyNames
+                         && band < LEGACY_BAND_NAMES.size()
+                         && std::find(LEGACY_BAND_SETTINGS.begin(), LEGACY_BAND_SETTINGS.end(), name) != LEGACY_BAND_SETTINGS.end();
+            
+            names[band][name] = isLegacy ? prefix + " " + LEGACY_BAND_NAMES[band] + " Band"
+                                         : prefix + infix + juce::String(band + 1);
+        }
+    }
+        
+    return names;
+}
+
+const std::array<std::map<BandNames, juce::String>, MAX_BANDS>& GetBandParams()
+{
+    static auto params = makeBandParams(" Band ", true);
+    return params;
+}
+
+const std::array<std::map<BandNames, juce::String>, MAX_BANDS>& GetSideBandParams()
+{
+    static auto params = makeBandParams(" Side Band ", false);
+    return params;
+}
+
+const std::array<juce::String, MAX_CROSSOVERS>& GetCrossoverParams()
+{
+    static auto params = []()
+    {
+        //the two crossovers of the 3 band versions keep their IDs, typo included
+        std::array<juce::String, MAX_CROSSOVERS> names { "Low-Mid Crossover Freq", "Mid_High Crossover Freq" };
+        for( size_t i = 2; i < names.size(); ++i )
+        {
+            names[i] = "Crossover " + juce::String(i + 1) + "-" + juce::String(i + 2) + " Freq";
+        }
+        
+        return names;
+    }();
+    
+    return params;
+}
+
+const juce::StringArray& GetRatioChoiceNames()
+{
+    static auto names = []()
+    {
+        juce::StringArray sa;
+        for( auto choice : RATIO_CHOICES )
+        {
+            sa.add( juce::String(choice, 1) );
+        }
+        
+        return sa;
+    }();
+    
+    return names;
+}
+}
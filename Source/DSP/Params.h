@@ -14,77 +14,99 @@
 
 namespace Params
 {
+static constexpr size_t MIN_BANDS = 2;
+static constexpr size_t MAX_BANDS = 8;
+static constexpr size_t MAX_CROSSOVERS = MAX_BANDS - 1;
+
+/*
+ the widest bus accepted, i.e. 7.1.4 or 3rd order ambisonics.
+ every channel is processed the same way, each in its own SIMD lane.
+ */
+static constexpr size_t MAX_CHANNELS = 16;
+
+/*
+ the values behind the Ratio parameter's choices, in the same order.
+ the audio thread looks ratios up here instead of parsing the choice names.
+ */
+static constexpr std::array<float, 14> RATIO_CHOICES { 1.f, 1.5f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 10.f, 15.f, 20.f, 50.f, 100.f };
+
+/*
+ the compressors run at (1 << order) times the host rate
+ */
+static constexpr size_t MAX_OVERSAMPLING_ORDER = 3;
+
+static constexpr float MAX_LOOKAHEAD_MS = 10.f;
+
+/*
+ the Crossover Mode parameter's choices, in the same order
+ */
+enum CrossoverModes
+{
+    Minimum_Phase,
+    Linear_Phase,
+};
+
+/*
+ the Stereo Mode parameter's choices, in the same order.
+ Mid_Side only applies to stereo buses, wider and mono ones are always processed as they are.
+ */
+enum StereoModes
+{
+    Left_Right,
+    Mid_Side,
+};
+
 enum Names
 {
-    Low_Mid_Crossover_Freq,
-    Mid_High_Crossover_Freq,
-    
-    Threshold_Low_Band,
-    Threshold_Mid_Band,
-    Threshold_High_Band,
-    
-    Attack_Low_Band,
-    Attack_Mid_Band,
-    Attack_High_Band,
-    
-    Release_Low_Band,
-    Release_Mid_Band,
-    Release_High_Band,
-    
-    Ratio_Low_Band,
-    Ratio_Mid_Band,
-    Ratio_High_Band,
-    
-    Bypassed_Low_Band,
-    Bypassed_Mid_Band,
-    Bypassed_High_Band,
-    
-    Mute_Low_Band,
-    Mute_Mid_Band,
-    Mute_High_Band,
-    
-    Solo_Low_Band,
-    Solo_Mid_Band,
-    Solo_High_Band,
+    Number_Of_Bands,
+    Oversampling,
+    Lookahead,
+    Crossover_Mode,
+    Stereo_Mode,
     
     Gain_In,
     Gain_Out,
 };
 
-inline const std::map<Names, juce::String>& GetParams()
+/*
+ every band owns one of each of these.
+ the parameter names are generated per band, i.e. "Attack Band 4".
+ the first three bands keep the IDs the 3 band versions saved, i.e. "Attack Low Band", see Params.cpp.
+ */
+enum BandNames
 {
-    static std::map<Names, juce::String> params =
-    {
-        {Low_Mid_Crossover_Freq, "Low-Mid Crossover Freq"},
-        {Mid_High_Crossover_Freq,"Mid_High Crossover Freq"},
-        {Threshold_Low_Band,"Threshold Low Band"},
-        {Threshold_Mid_Band,"Threshold Mid Band"},
-        {Threshold_High_Band,"Threshold High Band"},
-        {Attack_Low_Band,"Attack Low Band"},
-        {Attack_Mid_Band,"Attack Mid Band"},
-        {Attack_High_Band,"Attack High Band"},
-        {Release_Low_Band,"Release Low Band"},
-        {Release_Mid_Band,"Release Mid Band"},
-        {Release_High_Band,"Release High Band"},
-        {Ratio_Low_Band,"Ratio Low Band"},
-        {Ratio_Mid_Band,"Ratio Mid Band"},
-        {Ratio_High_Band,"Ratio High Band"},
-        {Bypassed_Low_Band,"Bypassed Low Band"},
-        {Bypassed_Mid_Band,"Bypassed Mid Band"},
-        {Bypassed_High_Band,"Bypassed High Band"},
-        
-        {Mute_Low_Band,"Mute Low Band"},
-        {Mute_Mid_Band,"Mute Mid Band"},
-        {Mute_High_Band,"Mute High Band"},
-        
-        {Solo_Low_Band,"Solo Low Band"},
-        {Solo_Mid_Band,"Solo Mid Band"},
-        {Solo_High_Band,"Solo High Band"},
-        
-        {Gain_In,"Gain In"},
-        {Gain_Out,"Gain Out"},
-    };
-    
-    return params;
-}
+    Threshold,
+    Knee,
+    Attack,
+    Release,
+    Ratio,
+    Bypassed,
+    Mute,
+    Solo,
+    Sidechain,
+};
+
+const std::map<Names, juce::String>& GetParams();
+
+/*
+ GetBandParams()[band] holds the names of every parameter belonging to 'band'
+ */
+const std::array<std::map<BandNames, juce::String>, MAX_BANDS>& GetBandParams();
+
+/*
+ the side channel's settings in Mid/Side mode, i.e. "Attack Side Band 3".
+ in Left/Right mode they are ignored.
+ */
+const std::array<std::map<BandNames, juce::String>, MAX_BANDS>& GetSideBandParams();
+
+/*
+ GetCrossoverParams()[i] is the crossover between band i and band i + 1.
+ the first two keep the IDs the 3 band versions saved.
+ */
+const std::array<juce::String, MAX_CROSSOVERS>& GetCrossoverParams();
+
+/*
+ the Ratio parameter's choices, RATIO_CHOICES as text
+ */
+const juce::StringArray& GetRatioChoiceNames();
 }
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    ProcessingSnapshot.h
+    Created: 18 Oct 2026 1:37:52pm
+    Author:  matkatmusic
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "CompressorBand.h"
+#include "Params.h"
+
+namespace SimpleMBComp
+{
+using CompressorBands = std::array<CompressorBand, Params::MAX_BANDS>;
+using CrossoverFrequencies = std::array<float, Params::MAX_CROSSOVERS>;
+
+/*
+ every parameter the audio thread reads, loaded once at the top of processBlock().
+ every stage of the block reads this instead of the parameters, so a parameter the host
+ changes halfway through a block only takes effect from the next one.
+
+ written by the audio thread only.  the band workers read it while a chunk is compressed,
+ handing them the chunk publishes it.
+ */
+struct ProcessingSnapshot
+{
+    size_t numBands { Params::MIN_BANDS };
+
+    //mid/side is only ever set for stereo buses
+    bool midSide { false };
+    bool linearPhase { false };
+    int oversamplingOrder { 0 };
+    float lookaheadMs { 0.f };
+    float inputGainDb { 0.f };
+    float outputGainDb { 0.f };
+
+    //already kept from passing the one below them
+    CrossoverFrequencies crossovers {};
+
+    /*
+     only the first numBands are read, the side bands only in mid/side mode.
+     nothing reads the others.
+     */
+    std::array<CompressorBand::Settings, Params::MAX_BANDS> bands {}, sideBands {};
+
+    void readBands(const CompressorBands& compressors, const CompressorBands& sideCompressors)
+    {
+        for( size_t i = 0; i < numBands; ++i )
+        {
+            bands[i] = compressors[i].readParameters();
+            if( midSide )
+                sideBands[i] = sideCompressors[i].readParameters();
+        }
+    }
+
+    //true if any band in use, or its side, has 'flag' set
+    bool isSetForAnyBand(bool CompressorBand::Settings::* flag) const
+    {
+        for( size_t i = 0; i < numBands; ++i )
+        {
+            if( bands[i].*flag || (midSide && sideBands[i].*flag) )
+                return true;
+        }
+
+        return false;
+    }
+
+    float getLongestReleaseMs() const
+    {
+        auto releaseMs = 0.f;
+        for( size_t i = 0; i < numBands; ++i )
+        {
+            releaseMs = juce::jmax(releaseMs, bands[i].releaseMs);
+            if( midSide )
+                releaseMs = juce::jmax(releaseMs, sideBands[i].releaseMs);
+        }
+
+        return releaseMs;
+    }
+};
+} //end namespace SimpleMBComp
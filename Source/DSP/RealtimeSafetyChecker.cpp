@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+    
+    RealtimeSafetyChecker.cpp
+    Created: 16 Oct 2026 5:07:31pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "RealtimeSafetyChecker.h"
+
+#if SIMPLEMBCOMP_REALTIME_CHECKS
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#else
+ #include <execinfo.h>
+#endif
+
+extern "C"
+{
+    void* simplembcomp_rt_real_malloc(size_t size);
+    void simplembcomp_rt_real_free(void* ptr);
+}
+
+namespace SimpleMBComp
+{
+namespace RealtimeSafety
+{
+namespace
+{
+/*
+ everything the hooks touch is either thread_local or a plain array,
+ so recording a violation can neither allocate nor lock.
+ */
+thread_local int realtimeDepth = 0;
+thread_local bool isRecording = false;
+thread_local const char* sectionFile = nullptr;
+thread_local int sectionLine = 0;
+
+constexpr size_t MaxRecordedViolations = 256;
+std::array<Violation, MaxRecordedViolations> recordedViolations;
+std::atomic<size_t> numViolations { 0 };
+
+int captureStack(std::array<void*, Violation::MaxFrames>& stack)
+{
+   #if JUCE_WINDOWS
+    return static_cast<int>(CaptureStackBackTrace(0, static_cast<DWORD>(stack.size()), stack.data(), nullptr));
+   #else
+    return backtrace(stack.data(), static_cast<int>(stack.size()));
+   #endif
+}
+
+/*
+ backtrace() loads its unwinder the first time it runs, which allocates.
+ get that out of the way before any audio thread exists.
+ */
+const int stackCapturePrimed = []()
+{
+    std::array<void*, Violation::MaxFrames> stack;
+    return captureStack(stack);
+}();
+
+void record(const char* function)
+{
+    auto index = numViolations.fetch_add(1);
+    if( index >= recordedViolations.size() )
+        return;
+    
+    auto& violation = recordedViolations[index];
+    violation.function = function;
+    violation.file = sectionFile;
+    violation.line = sectionLine;
+    violation.numFrames = captureStack(violation.stack);
+}
+} //end anonymous namespace
+
+ScopedRealtimeSection::ScopedRealtimeSection(const char* file, int line) :
+previousFile(sectionFile),
+previousLine(sectionLine)
+{
+    sectionFile = file;
+    sectionLine = line;
+    ++realtimeDepth;
+}
+
+ScopedRealtimeSection::~ScopedRealtimeSection()
+{
+    --realtimeDepth;
+    sectionFile = previousFile;
+    sectionLine = previousLine;
+}
+
+size_t getNumViolations()
+{
+    return numViolations.load();
+}
+
+std::vector<Violation> getViolations()
+{
+    auto num = juce::jmin(getNumViolations(), recordedViolations.size());
+    return std::vector<Violation>(recordedViolations.begin(),
+                                  recordedViolations.begin() + static_cast<std::ptrdiff_t>(num));
+}
+
+void clearViolations()
+{
+    numViolations.store(0);
+}
+
+juce::String describeViolations()
+{
+    juce::String description;
+    for( const auto& violation : getViolations() )
+    {
+        description << violation.function << " called inside the realtime section opened at "
+                    << violation.file << ":" << violation.line << juce::newLine;
+                    
+       #if JUCE_WINDOWS
+        for( int i = 0; i < violation.numFrames; ++i )
+            description << "    " << juce::String::toHexString(reinterpret_cast<juce::pointer_sized_int>(violation.stack[static_cast<size_t>(i)])) << juce::newLine;
+       #else
+        auto** symbols = backtrace_symbols(violation.stack.data(), violation.numFrames);
+        for( int i = 0; i < violation.numFrames; ++i )
+            description << "    " << (symbols != nullptr ? symbols[i] : "?") << juce::newLine;
+        
+        ::free(symbols);
+       #endif
+    }
+    
+    auto total = getNumViolations();
+    if( total > recordedViolations.size() )
+        description << (total - recordedViolations.size()) << " more not recorded" << juce::newLine;
+    
+    return description;
+}
+} //end namespace RealtimeSafety
+} //end namespace SimpleMBComp
+
+//=============================================================================
+/*
+ called by every hook in RealtimeSafetyInterposers.c and by the operator new/delete below.
+ */
+extern "C" void simplembcomp_rt_violation(const char* function)
+{
+    using namespace SimpleMBComp::RealtimeSafety;
+    
+    //recording may itself call a hooked function
+    if( realtimeDepth == 0 || isRecording )
+        return;
+    
+    isRecording = true;
+    record(function);
+    isRecording = false;
+}
+
+/*
+ libc++ on macOS allocates through the system malloc, which the C hooks don't see from here,
+ and on Windows the C hooks don't exist at all. catch C++ allocations directly.
+ */
+static void* checkedNew(std::size_t size, const char* function)
+{
+    simplembcomp_rt_violation(function);
+    if( auto* ptr = simplembcomp_rt_real_malloc(size == 0 ? 1 : size) )
+        return ptr;
+    
+    throw std::bad_alloc();
+}
+
+static void checkedDelete(void* ptr, const char* function)
+{
+    if( ptr == nullptr )
+        return;
+    
+    simplembcomp_rt_violation(function);
+    simplembcomp_rt_real_free(ptr);
+}
+
+/*
+ over-aligned allocations keep the offset to the real block just in front of the aligned pointer
+ */
+static void* checkedAlignedNew(std::size_t size, std::align_val_t alignment, const char* function)
+{
+    auto align = static_cast<std::size_t>(alignment);
+    auto* raw = static_cast<char*>(checkedNew(size + align + sizeof(void*), function));
+    auto aligned = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + align - 1) & ~(align - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+static void checkedAlignedDelete(void* ptr, const char* function)
+{
+    if( ptr != nullptr )
+        checkedDelete(static_cast<void**>(ptr)[-1], function);
+}
+
+void* operator new(std::size_t size) { return checkedNew(size, "operator new"); }
+void* operator new[](std::size_t size) { return checkedNew(size, "operator new[]"); }
+void* operator new(std::size_t size, std::align_val_t align) { return checkedAlignedNew(size, align, "operator new"); }
+void* operator new[](std::size_t size, std::align_val_t align) { return checkedAlignedNew(size, align, "operator new[]"); }
+
+void operator delete(void* ptr) noexcept { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr) noexcept { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::size_t) noexcept { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { checkedAlignedDelete(ptr, "operator delete[]"); }
+
+#endif //SIMPLEMBCOMP_REALTIME_CHECKS
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+    
+    RealtimeSafetyChecker.h
+    Created: 16 Oct 2026 5:07:31pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ build with SIMPLEMBCOMP_REALTIME_CHECKS=1 (the RealtimeCheck configuration) to record
+ every allocation, lock and blocking call made while a ScopedRealtimeSection is alive.
+ without it everything in here compiles away.
+ */
+#ifndef SIMPLEMBCOMP_REALTIME_CHECKS
+ #define SIMPLEMBCOMP_REALTIME_CHECKS 0
+#endif
+
+namespace SimpleMBComp
+{
+namespace RealtimeSafety
+{
+struct Violation
+{
+    static constexpr int MaxFrames = 32;
+    
+    //the function that was called, i.e. "malloc"
+    const char* function = nullptr;
+    
+    //where the innermost ScopedRealtimeSection was opened
+    const char* file = nullptr;
+    int line = 0;
+    
+    std::array<void*, MaxFrames> stack {};
+    int numFrames = 0;
+};
+
+#if SIMPLEMBCOMP_REALTIME_CHECKS
+/*
+ marks the calling thread as realtime until it goes out of scope.
+ sections can be nested.
+ */
+struct ScopedRealtimeSection
+{
+    ScopedRealtimeSection(const char* file, int line);
+    ~ScopedRealtimeSection();
+private:
+    const char* previousFile;
+    int previousLine;
+    
+    JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeSection)
+};
+
+/*
+ the first violations are kept with their stacks, the rest are only counted.
+ none of these are realtime safe.
+ */
+size_t getNumViolations();
+std::vector<Violation> getViolations();
+void clearViolations();
+
+/*
+ one paragraph per recorded violation, with the stack symbolized
+ */
+juce::String describeViolations();
+#else
+struct ScopedRealtimeSection
+{
+    ScopedRealtimeSection(const char*, int) { }
+};
+
+inline size_t getNumViolations() { return 0; }
+inline std::vector<Violation> getViolations() { return {}; }
+inline void clearViolations() { }
+inline juce::String describeViolations() { return {}; }
+#endif
+} //end namespace RealtimeSafety
+} //end namespace SimpleMBComp
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+    
+    RealtimeSafetyInterposers.c
+    Created: 16 Oct 2026 5:07:31pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+/*
+ replacements for the C library functions that must not be called on the audio thread.
+ each one reports itself to the checker and then forwards to the real function.
+ 
+ this is C on purpose: the C++ declarations of these functions carry exception
+ specifications that differ between platforms, which makes redefining them from C++ fragile.
+ 
+ only the code linked into the same binary as this file is checked, so run the
+ checker from an executable (the Standalone build or a test runner), not from a plugin
+ loaded by a host.
+ */
+ 
+#ifndef SIMPLEMBCOMP_REALTIME_CHECKS
+ #define SIMPLEMBCOMP_REALTIME_CHECKS 0
+#endif
+
+#if SIMPLEMBCOMP_REALTIME_CHECKS
+
+#include <stddef.h>
+#include <stdlib.h>
+
+void simplembcomp_rt_violation(const char* function);
+
+#if defined (_WIN32)
+
+void* simplembcomp_rt_real_malloc(size_t size) { return malloc(size); }
+void simplembcomp_rt_real_free(void* ptr) { free(ptr); }
+
+#else
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined (__APPLE__)
+ #include <malloc/malloc.h>
+ 
+ static void* realMalloc(size_t size)              { return malloc_zone_malloc(malloc_default_zone(), size); }
+ static void* realCalloc(size_t num, size_t size)  { return malloc_zone_calloc(malloc_default_zone(), num, size); }
+ static void* realRealloc(void* ptr, size_t size)  { return malloc_zone_realloc(ptr != NULL ? malloc_zone_from_ptr(ptr) : malloc_default_zone(), ptr, size); }
+ static void realFree(void* ptr)                   { if( ptr != NULL ) malloc_zone_free(malloc_zone_from_ptr(ptr), ptr); }
+ static int realMemalign(void** ptr, size_t alignment, size_t size)
+ {
+     *ptr = malloc_zone_memalign(malloc_default_zone(), alignment, size);
+     return *ptr != NULL ? 0 : 12; //ENOMEM
+ }
+#else
+ //glibc exports its allocator under these names, so forwarding never goes through dlsym()
+ extern void* __libc_malloc(size_t);
+ extern void* __libc_calloc(size_t, size_t);
+ extern void* __libc_realloc(void*, size_t);
+ extern void __libc_free(void*);
+ extern void* __libc_memalign(size_t, size_t);
+ 
+ static void* realMalloc(size_t size)              { return __libc_malloc(size); }
+ static void* realCalloc(size_t num, size_t size)  { return __libc_calloc(num, size); }
+ static void* realRealloc(void* ptr, size_t size)  { return __libc_realloc(ptr, size); }
+ static void realFree(void* ptr)                   { __libc_free(ptr); }
+ static int realMemalign(void** ptr, size_t alignment, size_t size)
+ {
+     *ptr = __libc_memalign(alignment, size);
+     return *ptr != NULL ? 0 : 12; //ENOMEM
+ }
+#endif
+
+void* simplembcomp_rt_real_malloc(size_t size) { return realMalloc(size); }
+void simplembcomp_rt_real_free(void* ptr) { realFree(ptr); }
+
+//=============================================================================
+void* malloc(size_t size)
+{
+    simplembcomp_rt_violation("malloc");
+    return realMalloc(size);
+}
+
+void* calloc(size_t num, size_t size)
+{
+    simplembcomp_rt_violation("calloc");
+    return realCalloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    simplembcomp_rt_violation("realloc");
+    return realRealloc(ptr, size);
+}
+
+void free(void* ptr)
+{
+    if( ptr != NULL )
+        simplembcomp_rt_violation("free");
+    
+    realFree(ptr);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size)
+{
+    simplembcomp_rt_violation("posix_memalign");
+    return realMemalign(ptr, alignment, size);
+}
+
+//=============================================================================
+/*
+ everything below is looked up with dlsym() the first time it's called.
+ */
+#define SIMPLEMBCOMP_FORWARD(returnType, name, params, args)        \
+    returnType name params                                          \
+    {                                                               \
+        typedef returnType (*Function) params;                      \
+        static Function real = NULL;                                \
+        if( real == NULL )                                          \
+            real = (Function) dlsym(RTLD_NEXT, #name);              \
+                                                                    \
+        simplembcomp_rt_violation(#name);                           \
+        return real args;                                           \
+    }
+
+SIMPLEMBCOMP_FORWARD(int, pthread_mutex_lock, (pthread_mutex_t* mutex), (mutex))
+SIMPLEMBCOMP_FORWARD(int, pthread_cond_wait, (pthread_cond_t* cond, pthread_mutex_t* mutex), (cond, mutex))
+SIMPLEMBCOMP_FORWARD(int, pthread_cond_timedwait, (pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* time), (cond, mutex, time))
+SIMPLEMBCOMP_FORWARD(int, pthread_join, (pthread_t thread, void** result), (thread, result))
+SIMPLEMBCOMP_FORWARD(int, nanosleep, (const struct timespec* duration, struct timespec* remaining), (duration, remaining))
+SIMPLEMBCOMP_FORWARD(int, usleep, (unsigned int microseconds), (microseconds))
+SIMPLEMBCOMP_FORWARD(unsigned int, sleep, (unsigned int seconds), (seconds))
+SIMPLEMBCOMP_FORWARD(FILE*, fopen, (const char* path, const char* mode), (path, mode))
+SIMPLEMBCOMP_FORWARD(long, read, (int fd, void* data, size_t size), (fd, data, size))
+SIMPLEMBCOMP_FORWARD(long, write, (int fd, const void* data, size_t size), (fd, data, size))
+
+#undef SIMPLEMBCOMP_FORWARD
+
+#endif //_WIN32
+#endif //SIMPLEMBCOMP_REALTIME_CHECKS
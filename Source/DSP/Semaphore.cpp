@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+    
+    Semaphore.cpp
+    Created: 19 Oct 2026 2:26:08pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#include "Semaphore.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <cerrno>
+ #include <semaphore.h>
+#endif
+
+namespace SimpleMBComp
+{
+struct Semaphore::Native
+{
+#if JUCE_WINDOWS
+    Native() : handle(CreateSemaphoreW(nullptr, 0, MAXLONG, nullptr)) { }
+    ~Native() { CloseHandle(handle); }
+    void post() { ReleaseSemaphore(handle, 1, nullptr); }
+    void wait() { WaitForSingleObject(handle, INFINITE); }
+    
+    HANDLE handle;
+#elif JUCE_MAC || JUCE_IOS
+    Native() : handle(dispatch_semaphore_create(0)) { }
+    ~Native() { dispatch_release(handle); }
+    void post() { dispatch_semaphore_signal(handle); }
+    void wait() { dispatch_semaphore_wait(handle, DISPATCH_TIME_FOREVER); }
+    
+    dispatch_semaphore_t handle;
+#else
+    Native() { sem_init(&handle, 0, 0); }
+    ~Native() { sem_destroy(&handle); }
+    void post() { sem_post(&handle); }
+    
+    void wait()
+    {
+        //a signal handler interrupting the wait is not a post
+        while( sem_wait(&handle) != 0 && errno == EINTR ) { }
+    }
+    
+    sem_t handle;
+#endif
+    
+    JUCE_DECLARE_NON_COPYABLE(Native)
+};
+
+Semaphore::Semaphore() : native(std::make_unique<Native>())
+{
+}
+
+Semaphore::~Semaphore() = default;
+
+void Semaphore::post()
+{
+    native->post();
+}
+
+void Semaphore::wait()
+{
+    native->wait();
+}
+} //end namespace SimpleMBComp
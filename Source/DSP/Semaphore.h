@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+    
+    Semaphore.h
+    Created: 19 Oct 2026 2:26:08pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace SimpleMBComp
+{
+/*
+ a counting semaphore on the platform's own primitive.
+ juce::WaitableEvent::signal() locks a mutex, post() doesn't, so the audio thread can wake a thread with it.
+ */
+struct Semaphore
+{
+    Semaphore();
+    ~Semaphore();
+    
+    void post();
+    
+    //blocks until there is a post to take
+    void wait();
+private:
+    struct Native;
+    std::unique_ptr<Native> native;
+    
+    JUCE_DECLARE_NON_COPYABLE(Semaphore)
+};
+} //end namespace SimpleMBComp
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+    
+    SharedDelayLine.h
+    Created: 16 Oct 2026 6:11:40pm
+    Author:  matkatmusic
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace SimpleMBComp
+{
+/*
+ one circular buffer holding a row per (band, channel).
+ every band delays its own rows, so the bands share a single preallocated
+ buffer instead of each keeping a delay line of its own.
+ */
+template<typename SampleType>
+struct SharedDelayLine
+{
+    /*
+     allocates everything.  process() never does.
+     */
+    void prepare(size_t numRows, size_t maxDelaySamples)
+    {
+        capacity = static_cast<size_t>(juce::nextPowerOfTwo(static_cast<int>(maxDelaySamples) + 1));
+        mask = capacity - 1;
+        maxDelay = maxDelaySamples;
+        
+        buffer.setSize(static_cast<int>(numRows), static_cast<int>(capacity));
+        rows = buffer.getArrayOfWritePointers();
+        writePositions.assign(numRows, 0);
+        
+        reset();
+    }
+    
+    void reset()
+    {
+        clearRows(0, writePositions.size());
+        std::fill(writePositions.begin(), writePositions.end(), 0);
+    }
+    
+    //for a band that stopped writing to its rows and is about to start again
+    void clearRows(size_t firstRow, size_t numRows)
+    {
+        for( auto row = firstRow; row < firstRow + numRows; ++row )
+            juce::FloatVectorOperations::clear(rows[row], static_cast<int>(capacity));
+    }
+    
+    size_t getMaxDelay() const { return maxDelay; }
+    
+    /*
+     channel ch of 'block' goes into row firstRow + ch.
+     'block' is replaced with what was written to those rows 'delay' samples ago.
+     */
+    void process(size_t firstRow, juce::dsp::AudioBlock<SampleType> block, size_t delay)
+    {
+        jassert(delay <= maxDelay);
+        jassert(firstRow + block.getNumChannels() <= static_cast<size_t>(buffer.getNumChannels()));
+        
+        const auto numSamples = block.getNumSamples();
+        for( size_t ch = 0; ch < block.getNumChannels(); ++ch )
+        {
+            auto row = firstRow + ch;
+            auto* line = rows[row];
+            auto* samples = block.getChannelPointer(ch);
+            auto write = writePositions[row];
+            
+            for( size_t i = 0; i < numSamples; ++i )
+            {
+                line[write] = samples[i];
+                samples[i] = line[(write - delay) & mask];
+                write = (write + 1) & mask;
+            }
+            
+            writePositions[row] = write;
+        }
+    }
+private:
+    juce::AudioBuffer<SampleType> buffer;
+    
+    /*
+     the rows are only ever touched through these, never through 'buffer'.
+     getWritePointer() and clear() update a flag shared by every row,
+     and bands on different threads write to their own rows at the same time.
+     */
+    SampleType* const* rows = nullptr;
+    std::vector<size_t> writePositions;
+    size_t capacity = 0, mask = 0, maxDelay = 0;
+};
+} //end namespace SimpleMBComp
@@ -22,6 +22,12 @@ enum Channel
     Right, //effectively 1
 };
 
+/*
+ the analyzer gets buffers of this many samples whatever block size the host uses.
+ it has to fit into the smallest FFT, the analyzer keeps only the newest FFT size worth of samples.
+ */
+static constexpr int ANALYZER_BLOCK_SIZE = 512;
+
 template<typename BlockType>
 struct SingleChannelSampleFifo
 {
@@ -30,23 +36,37 @@ struct SingleChannelSampleFifo
         prepared.set(false);
     }
     
-    void update(const BlockType& buffer)
+    //'buffer' may hold doubles, the analyzer only ever sees floats
+    template<typename OtherBlockType>
+    void update(const OtherBlockType& buffer)
     {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse );
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(buffer.getNumChannels() > 0);
+        
+        auto channel = juce::jmin(channelIndex, buffer.getNumChannels() - 1);
+        auto* channelPtr = buffer.getReadPointer(channel);
         
         for( int i = 0; i < buffer.getNumSamples(); ++i )
         {
-            pushNextSampleIntoFifo(channelPtr[i]);
+            pushNextSampleIntoFifo(static_cast<float>(channelPtr[i]));
         }
     }
 
-    void prepare(int bufferSize)
+    /*
+     'channels' is the layout of the buses passed to update().
+     wider buses are analyzed by their left and right channels where they have them, ambisonic ones
+     for example don't, those are analyzed by their first two channels.
+     a mono bus feeds both analyzers from its only channel.
+     */
+    void prepare(int bufferSize, const juce::AudioChannelSet& channels)
     {
         prepared.set(false);
         size.set(bufferSize);
         
+        auto type = channelToUse == Channel::Left ? juce::AudioChannelSet::left : juce::AudioChannelSet::right;
+        auto index = channels.getChannelIndexForType(type);
+        channelIndex = index >= 0 ? index : static_cast<int>(channelToUse);
+        
         bufferToFill.setSize(1,             //channel
                              bufferSize,    //num samples
                              false,         //keepExistingContent
@@ -64,6 +84,7 @@ struct SingleChannelSampleFifo
     bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
 private:
     Channel channelToUse;
+    int channelIndex = static_cast<int>(channelToUse);
     int fifoIndex = 0;
     Fifo<BlockType> audioBufferFifo;
     BlockType bufferToFill;
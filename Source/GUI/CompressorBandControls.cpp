@@ -19,11 +19,13 @@ apvts(apv),
 attackSlider(nullptr, "ms", "ATTACK"),
 releaseSlider(nullptr, "ms", "RELEASE"),
 thresholdSlider(nullptr, "dB", "THRESH"),
+kneeSlider(nullptr, "dB", "KNEE"),
 ratioSlider(nullptr, "")
 {
     addAndMakeVisible(attackSlider);
     addAndMakeVisible(releaseSlider);
     addAndMakeVisible(thresholdSlider);
+    addAndMakeVisible(kneeSlider);
     addAndMakeVisible(ratioSlider);
     
     bypassButton.addListener(this);
@@ -48,53 +50,72 @@ ratioSlider(nullptr, "")
     muteButton.setColour(juce::TextButton::ColourIds::buttonColourId,
                          juce::Colours::black);
     
+    //keys the band's detector from the sidechain input instead of the band itself
+    sidechainButton.setName("K");
+    sidechainButton.setColour(juce::TextButton::ColourIds::buttonOnColourId,
+                              juce::Colours::orange);
+    sidechainButton.setColour(juce::TextButton::ColourIds::buttonColourId,
+                              juce::Colours::black);
+    
+    sideButton.setName("SIDE");
+    sideButton.setColour(juce::TextButton::ColourIds::buttonOnColourId,
+                         juce::Colours::cyan.darker());
+    sideButton.setColour(juce::TextButton::ColourIds::buttonColourId,
+                         juce::Colours::black);
+    
     addAndMakeVisible(bypassButton);
     addAndMakeVisible(soloButton);
     addAndMakeVisible(muteButton);
+    addAndMakeVisible(sidechainButton);
+    addChildComponent(sideButton);
     
-    lowBand.setName("Low");
-    lowBand.setColour(juce::TextButton::ColourIds::buttonOnColourId,
-                      ColorScheme::getSliderBorderColor());
-    lowBand.setColour(juce::TextButton::ColourIds::buttonColourId,
-                      juce::Colours::black);
-    
-    midBand.setName("Mid");
-    midBand.setColour(juce::TextButton::ColourIds::buttonOnColourId,
-                      ColorScheme::getSliderBorderColor());
-    midBand.setColour(juce::TextButton::ColourIds::buttonColourId,
-                      juce::Colours::black);
+    auto buttonSwitcher = [safePtr = this->safePtr]()
+    {
+        if( auto* c = safePtr.getComponent() )
+        {
+            c->updateAttachments();
+        }
+    };
     
-    highBand.setName("High");
-    highBand.setColour(juce::TextButton::ColourIds::buttonOnColourId,
+    for( size_t i = 0; i < bandSelectButtons.size(); ++i )
+    {
+        auto& band = bandSelectButtons[i];
+        band.setName(juce::String(i + 1));
+        band.setColour(juce::TextButton::ColourIds::buttonOnColourId,
                        ColorScheme::getSliderBorderColor());
-    highBand.setColour(juce::TextButton::ColourIds::buttonColourId,
-                      juce::Colours::black);
+        band.setColour(juce::TextButton::ColourIds::buttonColourId,
+                       juce::Colours::black);
+        
+        band.setRadioGroupId(1);
+        band.onClick = buttonSwitcher;
+        
+        addChildComponent(band);
+    }
     
-    lowBand.setRadioGroupId(1);
-    midBand.setRadioGroupId(1);
-    highBand.setRadioGroupId(1);
+    bandSelectButtons[0].setToggleState(true, juce::NotificationType::dontSendNotification);
     
-    auto buttonSwitcher = [safePtr = this->safePtr]()
+    sideButton.onClick = [safePtr = this->safePtr]()
     {
         if( auto* c = safePtr.getComponent() )
         {
+            for( auto& band : c->bandSelectButtons )
+            {
+                band.setColour(juce::TextButton::ColourIds::buttonOnColourId,
+                               ColorScheme::getSliderBorderColor());
+                band.setColour(juce::TextButton::ColourIds::buttonColourId,
+                               juce::Colours::black);
+                band.repaint();
+            }
+            
             c->updateAttachments();
+            c->updateSliderEnablements();
+            c->updateBandSelectButtonStates();
         }
     };
     
-    lowBand.onClick = buttonSwitcher;
-    midBand.onClick = buttonSwitcher;
-    highBand.onClick = buttonSwitcher;
-    
-    lowBand.setToggleState(true, juce::NotificationType::dontSendNotification);
-    
     updateAttachments();
     updateSliderEnablements();
     updateBandSelectButtonStates();
-    
-    addAndMakeVisible(lowBand);
-    addAndMakeVisible(midBand);
-    addAndMakeVisible(highBand);
 }
 
 CompressorBandControls::~CompressorBandControls()
@@ -128,8 +149,34 @@ void CompressorBandControls::resized()
         return flexBox;
     };
     
-    auto bandButtonControlBox = createBandButtonControlBox({&bypassButton, &soloButton, &muteButton});
-    auto bandSelectControlBox = createBandButtonControlBox({&lowBand, &midBand, &highBand});
+    std::vector<Component*> bandButtons {&bypassButton, &soloButton, &muteButton, &sidechainButton};
+    if( midSide )
+        bandButtons.push_back(&sideButton);
+    
+    auto bandButtonControlBox = createBandButtonControlBox(bandButtons);
+    
+    /*
+     more than 4 band select buttons don't fit in one column
+     */
+    const auto bandsPerColumn = numBands > 4 ? (numBands + 1) / 2 : numBands;
+    std::vector<Component*> firstColumn, secondColumn;
+    for( size_t i = 0; i < numBands; ++i )
+    {
+        (i < bandsPerColumn ? firstColumn : secondColumn).push_back(&bandSelectButtons[i]);
+    }
+    
+    auto firstColumnBox = createBandButtonControlBox(firstColumn);
+    auto secondColumnBox = createBandButtonControlBox(secondColumn);
+    
+    FlexBox bandSelectControlBox;
+    bandSelectControlBox.flexDirection = FlexBox::Direction::row;
+    bandSelectControlBox.flexWrap = FlexBox::Wrap::noWrap;
+    bandSelectControlBox.items.add(FlexItem(firstColumnBox).withFlex(1.f));
+    if( ! secondColumn.empty() )
+    {
+        bandSelectControlBox.items.add(FlexItem().withWidth(2));
+        bandSelectControlBox.items.add(FlexItem(secondColumnBox).withFlex(1.f));
+    }
     
     FlexBox flexBox;
     flexBox.flexDirection = FlexBox::Direction::row;
@@ -149,6 +196,8 @@ void CompressorBandControls::resized()
     flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(thresholdSlider).withFlex(1.f));
     flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(kneeSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(ratioSlider).withFlex(1.f));
 //    flexBox.items.add(endCap);
     flexBox.items.add(spacer);
@@ -174,18 +223,73 @@ void CompressorBandControls::buttonClicked(juce::Button *button)
 
 void CompressorBandControls::toggleAllBands(bool shouldBeBypassed)
 {
-    std::vector<Component*> bands { &lowBand, &midBand, &highBand};
-    for( auto* band : bands )
+    for( size_t i = 0; i < numBands; ++i )
+    {
+        auto& band = bandSelectButtons[i];
+        band.setColour(juce::TextButton::ColourIds::buttonOnColourId,
+                       shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) :
+                       ColorScheme::getSliderBorderColor());
+
+        band.setColour(juce::TextButton::ColourIds::buttonColourId,
+                       shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) :
+                       juce::Colours::black);
+        band.repaint();
+    }
+}
+
+void CompressorBandControls::setNumBands(size_t newNumBands)
+{
+    if( newNumBands == numBands )
+        return;
+    
+    numBands = newNumBands;
+    
+    for( size_t i = 0; i < bandSelectButtons.size(); ++i )
+    {
+        bandSelectButtons[i].setVisible( i < numBands );
+    }
+    
+    //the selected band no longer exists, so select the highest one that does.
+    if( getActiveBandIndex() >= numBands )
+    {
+        bandSelectButtons[numBands - 1].setToggleState(true, juce::NotificationType::sendNotification);
+    }
+    
+    resized();
+}
+
+void CompressorBandControls::setMidSide(bool isMidSide)
+{
+    if( isMidSide == midSide )
+        return;
+    
+    midSide = isMidSide;
+    sideButton.setVisible(midSide);
+    
+    //the side settings do nothing outside of mid/side mode, so go back to the ones that do
+    if( ! midSide && sideButton.getToggleState() )
     {
-        band->setColour(juce::TextButton::ColourIds::buttonOnColourId,
-                        shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) :
-                        ColorScheme::getSliderBorderColor());
+        sideButton.setToggleState(false, juce::NotificationType::sendNotification);
+    }
+    
+    resized();
+}
+
+const std::array<std::map<Params::BandNames, juce::String>, Params::MAX_BANDS>& CompressorBandControls::getEditedBandParams() const
+{
+    return sideButton.getToggleState() ? Params::GetSideBandParams() : Params::GetBandParams();
+}
 
-        band->setColour(juce::TextButton::ColourIds::buttonColourId,
-                        shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) :
-                        juce::Colours::black);
-        band->repaint();
+size_t CompressorBandControls::getActiveBandIndex() const
+{
+    for( size_t i = 0; i < bandSelectButtons.size(); ++i )
+    {
+        if( bandSelectButtons[i].getToggleState() )
+            return i;
     }
+    
+    jassertfalse;
+    return 0;
 }
 
 void CompressorBandControls::updateActiveBandFillColors(juce::Button &clickedButton)
@@ -226,38 +330,29 @@ void CompressorBandControls::updateBandSelectButtonStates()
 {
     using namespace Params;
     
-    std::vector<std::array<Names, 3>> paramsToCheck
-    {
-        {Names::Solo_Low_Band, Names::Mute_Low_Band, Names::Bypassed_Low_Band},
-        {Names::Solo_Mid_Band, Names::Mute_Mid_Band, Names::Bypassed_Mid_Band},
-        {Names::Solo_High_Band, Names::Mute_High_Band, Names::Bypassed_High_Band}
-    };
+    const auto& bandParams = getEditedBandParams();
     
-    const auto& params = GetParams();
-    auto paramHelper = [&params, this](const auto& name)
+    for( size_t i = 0; i < bandSelectButtons.size(); ++i )
     {
-        return dynamic_cast<juce::AudioParameterBool*>(&SimpleMBComp::getParam(apvts, params, name));
-    };
-    
-    for( size_t i = 0; i < paramsToCheck.size(); ++i )
-    {
-        auto& list = paramsToCheck[i];
+        const auto& params = bandParams[i];
+        auto paramHelper = [&params, this](const auto& name)
+        {
+            return dynamic_cast<juce::AudioParameterBool*>(&SimpleMBComp::getParam(apvts, params, name));
+        };
         
-        auto* bandButton = (i == 0) ? &lowBand :
-                           (i == 1) ? &midBand :
-                                      &highBand;
+        auto* bandButton = &bandSelectButtons[i];
         
-        if( auto* solo = paramHelper(list[0]);
+        if( auto* solo = paramHelper(BandNames::Solo);
            solo->get() )
         {
             refreshBandButtonColors(*bandButton, soloButton);
         }
-        else if( auto* mute = paramHelper(list[1]);
+        else if( auto* mute = paramHelper(BandNames::Mute);
                 mute->get() )
         {
             refreshBandButtonColors(*bandButton, muteButton);
         }
-        else if( auto* byp = paramHelper(list[2]);
+        else if( auto* byp = paramHelper(BandNames::Bypassed);
                 byp->get() )
         {
             refreshBandButtonColors(*bandButton, bypassButton);
@@ -272,6 +367,7 @@ void CompressorBandControls::updateSliderEnablements()
     attackSlider.setEnabled( !disabled );
     releaseSlider.setEnabled( !disabled );
     thresholdSlider.setEnabled( !disabled );
+    kneeSlider.setEnabled( !disabled );
     ratioSlider.setEnabled( !disabled );
 }
 
@@ -296,117 +392,45 @@ void CompressorBandControls::updateSoloMuteBypassToggleStates(juce::Button &clic
 
 void CompressorBandControls::updateAttachments()
 {
-    enum BandType
-    {
-        Low,
-        Mid,
-        High
-    };
-    
-    BandType bandType = [this]()
-    {
-        if( lowBand.getToggleState() )
-            return BandType::Low;
-        if( midBand.getToggleState() )
-            return BandType::Mid;
-        
-        return BandType::High;
-    }();
-    
     using namespace Params;
-    std::vector<Names> names;
-    
-    switch (bandType)
-    {
-        case Low:
-        {
-            names = std::vector<Names>
-            {
-                Names::Attack_Low_Band,
-                Names::Release_Low_Band,
-                Names::Threshold_Low_Band,
-                Names::Ratio_Low_Band,
-                Names::Mute_Low_Band,
-                Names::Solo_Low_Band,
-                Names::Bypassed_Low_Band
-            };
-            
-            activeBand = &lowBand;
-            break;
-        }
-        case Mid:
-        {
-            names = std::vector<Names>
-            {
-                Names::Attack_Mid_Band,
-                Names::Release_Mid_Band,
-                Names::Threshold_Mid_Band,
-                Names::Ratio_Mid_Band,
-                Names::Mute_Mid_Band,
-                Names::Solo_Mid_Band,
-                Names::Bypassed_Mid_Band
-            };
-            
-            activeBand = &midBand;
-            break;
-        }
-        case High:
-        {
-            names = std::vector<Names>
-            {
-                Names::Attack_High_Band,
-                Names::Release_High_Band,
-                Names::Threshold_High_Band,
-                Names::Ratio_High_Band,
-                Names::Mute_High_Band,
-                Names::Solo_High_Band,
-                Names::Bypassed_High_Band
-            };
-            
-            activeBand = &highBand;
-            break;
-        }
-    }
     
-    enum Pos
-    {
-        Attack,
-        Release,
-        Threshold,
-        Ratio,
-        Mute,
-        Solo,
-        Bypass
-    };
+    auto band = getActiveBandIndex();
+    activeBand = &bandSelectButtons[band];
     
-    const auto& params = GetParams();
+    const auto& params = getEditedBandParams()[band];
     
-    auto getParamHelper = [&params, &apvts = this->apvts, &names](const auto& pos) -> auto&
+    auto getParamHelper = [&params, &apvts = this->apvts](const auto& name) -> auto&
     {
-        return SimpleMBComp::getParam(apvts, params, names.at(pos));
+        return SimpleMBComp::getParam(apvts, params, name);
     };
     
     attackSliderAttachment.reset();
     releaseSliderAttachment.reset();
     thresholdSliderAttachment.reset();
+    kneeSliderAttachment.reset();
     ratioSliderAttachment.reset();
     bypassButtonAttachment.reset();
     soloButtonAttachment.reset();
     muteButtonAttachment.reset();
+    sidechainButtonAttachment.reset();
     
-    auto& attackParam = getParamHelper(Pos::Attack);
+    auto& attackParam = getParamHelper(BandNames::Attack);
     SimpleMBComp::addLabelPairs(attackSlider.labels, attackParam, "ms");
     attackSlider.changeParam(&attackParam);
     
-    auto& releaseParam = getParamHelper(Pos::Release);
+    auto& releaseParam = getParamHelper(BandNames::Release);
     SimpleMBComp::addLabelPairs(releaseSlider.labels, releaseParam, "ms");
     releaseSlider.changeParam(&releaseParam);
     
-    auto& threshParam = getParamHelper(Pos::Threshold);
+    auto& threshParam = getParamHelper(BandNames::Threshold);
     SimpleMBComp::addLabelPairs(thresholdSlider.labels, threshParam, "dB");
     thresholdSlider.changeParam(&threshParam);
     
-    auto& ratioParamRap = getParamHelper(Pos::Ratio);
+    auto& kneeParam = getParamHelper(BandNames::Knee);
+    SimpleMBComp::addLabelPairs(kneeSlider.labels, kneeParam, "dB");
+    kneeSlider.changeParam(&kneeParam);
+    
+    auto& ratioParamRap = getParamHelper(BandNames::Ratio);
     ratioSlider.labels.clear();
     ratioSlider.labels.add({0.f, "1:1"});
     auto ratioParam = dynamic_cast<juce::AudioParameterChoice*>(&ratioParamRap);
@@ -421,11 +445,13 @@ void CompressorBandControls::updateAttachments()
         SimpleMBComp::makeAttachment(attachment, apvts, params, name, slider);
     };
     
-    makeAttachmentHelper(attackSliderAttachment, names[Pos::Attack], attackSlider);
-    makeAttachmentHelper(releaseSliderAttachment, names[Pos::Release], releaseSlider);
-    makeAttachmentHelper(thresholdSliderAttachment, names[Pos::Threshold], thresholdSlider);
-    makeAttachmentHelper(ratioSliderAttachment, names[Pos::Ratio], ratioSlider);
-    makeAttachmentHelper(bypassButtonAttachment, names[Pos::Bypass], bypassButton);
-    makeAttachmentHelper(soloButtonAttachment, names[Pos::Solo], soloButton);
-    makeAttachmentHelper(muteButtonAttachment, names[Pos::Mute], muteButton);
+    makeAttachmentHelper(attackSliderAttachment, BandNames::Attack, attackSlider);
+    makeAttachmentHelper(releaseSliderAttachment, BandNames::Release, releaseSlider);
+    makeAttachmentHelper(thresholdSliderAttachment, BandNames::Threshold, thresholdSlider);
+    makeAttachmentHelper(kneeSliderAttachment, BandNames::Knee, kneeSlider);
+    makeAttachmentHelper(ratioSliderAttachment, BandNames::Ratio, ratioSlider);
+    makeAttachmentHelper(bypassButtonAttachment, BandNames::Bypassed, bypassButton);
+    makeAttachmentHelper(soloButtonAttachment, BandNames::Solo, soloButton);
+    makeAttachmentHelper(muteButtonAttachment, BandNames::Mute, muteButton);
+    makeAttachmentHelper(sidechainButtonAttachment, BandNames::Sidechain, sidechainButton);
 }
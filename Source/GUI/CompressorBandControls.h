@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 
 #include "RotarySliderWithLabels.h"
+#include "../DSP/Params.h"
 
 struct CompressorBandControls : juce::Component, juce::Button::Listener
 {
@@ -24,28 +25,45 @@ struct CompressorBandControls : juce::Component, juce::Button::Listener
     void buttonClicked(juce::Button* button) override;
     
     void toggleAllBands(bool shouldBeBypassed);
+    
+    /*
+     only the band select buttons for the first 'numBands' bands are shown
+     */
+    void setNumBands(size_t numBands);
+    
+    /*
+     the SIDE button, which switches the controls over to the side band settings,
+     is only shown in mid/side mode
+     */
+    void setMidSide(bool isMidSide);
 private:
     juce::AudioProcessorValueTreeState& apvts;
     
-    RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider/*, ratioSlider*/;
+    RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider, kneeSlider/*, ratioSlider*/;
     RatioSlider ratioSlider;
     
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<Attachment> attackSliderAttachment,
                                 releaseSliderAttachment,
                                 thresholdSliderAttachment,
+                                kneeSliderAttachment,
                                 ratioSliderAttachment;
     
-    juce::ToggleButton bypassButton, soloButton, muteButton, lowBand, midBand, highBand;
+    juce::ToggleButton bypassButton, soloButton, muteButton, sidechainButton;
+    std::array<juce::ToggleButton, Params::MAX_BANDS> bandSelectButtons;
+    juce::ToggleButton sideButton;
+    size_t numBands { 0 };
+    bool midSide { false };
     
     using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<BtnAttachment>  bypassButtonAttachment,
                                     soloButtonAttachment,
-                                    muteButtonAttachment;
+                                    muteButtonAttachment,
+                                    sidechainButtonAttachment;
     
     juce::Component::SafePointer<CompressorBandControls> safePtr {this};
     
-    juce::ToggleButton* activeBand = &lowBand;
+    juce::ToggleButton* activeBand = &bandSelectButtons[0];
     
     void updateAttachments();
     void updateSliderEnablements();
@@ -58,4 +76,8 @@ private:
     
     void updateBandSelectButtonStates();
     
+    size_t getActiveBandIndex() const;
+    
+    //the names of the settings being edited, the mid (or left/right) ones or the side ones
+    const std::array<std::map<Params::BandNames, juce::String>, Params::MAX_BANDS>& getEditedBandParams() const;
 };
@@ -14,6 +14,7 @@
 
 #include "Utilities.h"
 #include "../DSP/Fifo.h"
+#include "../DSP/Kernels.h"
 
 namespace SimpleMBComp
 {
@@ -41,31 +42,11 @@ struct FFTDataGenerator
         
         int numBins = (int)fftSize / 2;
         
-        //normalize the fft values.
-        for( int i = 0; i < numBins; ++i )
-        {
-            auto v = fftData[static_cast<size_t>(i)];
-//            fftData[i] /= (float) numBins;
-            if( !std::isinf(v) && !std::isnan(v) )
-            {
-                v /= float(numBins);
-            }
-            else
-            {
-                v = 0.f;
-            }
-            fftData[static_cast<size_t>(i)] = v;
-        }
-        
-        float max = negativeInfinity;
-        //convert them to decibels
-        for( int i = 0; i < numBins; ++i )
-        {
-            auto data = juce::Decibels::gainToDecibels(fftData[static_cast<size_t>(i)],
-                                                       negativeInfinity);
-            fftData[static_cast<size_t>(i)] = data;
-            max = juce::jmax(data, max);
-        }
+        //normalize the fft values and convert them to decibels
+        Kernels::getActiveKernels().magnitudesToDecibels(fftData.data(),
+                                                         static_cast<size_t>(numBins),
+                                                         float(numBins),
+                                                         negativeInfinity);
         
 //        jassertfalse;
         
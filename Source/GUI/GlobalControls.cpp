@@ -25,24 +25,35 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     };
     
     auto& gainInParam = getParamHelper(Names::Gain_In);
-    auto& lowMidParam = getParamHelper(Names::Low_Mid_Crossover_Freq);
-    auto& midHighParam = getParamHelper(Names::Mid_High_Crossover_Freq);
+    auto& numBandsParam = getParamHelper(Names::Number_Of_Bands);
+    auto& oversamplingParam = getParamHelper(Names::Oversampling);
+    auto& lookaheadParam = getParamHelper(Names::Lookahead);
+    auto& crossoverModeParam = getParamHelper(Names::Crossover_Mode);
+    auto& stereoModeParam = getParamHelper(Names::Stereo_Mode);
     auto& gainOutParam = getParamHelper(Names::Gain_Out);
     
     inGainSlider = std::make_unique<RSWL>(&gainInParam,
                                           "dB",
                                           "INPUT TRIM");
-    lowMidXoverSlider = std::make_unique<RSWL>(&lowMidParam,
-                                               "Hz",
-                                               "LOW-MID X-OVER");
-    midHighXoverSlider = std::make_unique<RSWL>(&midHighParam,
-                                                "Hz",
-                                                "MID-HI X-OVER");
+    numBandsSlider = std::make_unique<RSWL>(&numBandsParam,
+                                            "",
+                                            "BANDS");
+    oversamplingSlider = std::make_unique<RSWL>(&oversamplingParam,
+                                                "",
+                                                "OVERSAMPLE");
+    lookaheadSlider = std::make_unique<RSWL>(&lookaheadParam,
+                                             "ms",
+                                             "LOOKAHEAD");
+    crossoverModeSlider = std::make_unique<RSWL>(&crossoverModeParam,
+                                                 "",
+                                                 "X-OVER MODE");
+    stereoModeSlider = std::make_unique<RSWL>(&stereoModeParam,
+                                              "",
+                                              "STEREO");
     outGainSlider = std::make_unique<RSWL>(&gainOutParam,
                                            "dB",
                                            "OUTPUT TRIM");
     
-    
     auto makeAttachmentHelper = [&params, &apvts](auto& attachment,
                                                   const auto& name,
                                                   auto& slider)
@@ -54,13 +65,25 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
                          Names::Gain_In,
                          *inGainSlider);
     
-    makeAttachmentHelper(lowMidXoverSliderAttachment,
-                         Names::Low_Mid_Crossover_Freq,
-                         *lowMidXoverSlider);
+    makeAttachmentHelper(numBandsSliderAttachment,
+                         Names::Number_Of_Bands,
+                         *numBandsSlider);
+    
+    makeAttachmentHelper(oversamplingSliderAttachment,
+                         Names::Oversampling,
+                         *oversamplingSlider);
+    
+    makeAttachmentHelper(lookaheadSliderAttachment,
+                         Names::Lookahead,
+                         *lookaheadSlider);
     
-    makeAttachmentHelper(midHighXoverSliderAttachment,
-                         Names::Mid_High_Crossover_Freq,
-                         *midHighXoverSlider);
+    makeAttachmentHelper(crossoverModeSliderAttachment,
+                         Names::Crossover_Mode,
+                         *crossoverModeSlider);
+    
+    makeAttachmentHelper(stereoModeSliderAttachment,
+                         Names::Stereo_Mode,
+                         *stereoModeSlider);
     
     makeAttachmentHelper(outGainSliderAttachment,
                          Names::Gain_Out,
@@ -69,22 +92,69 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     SimpleMBComp::addLabelPairs(inGainSlider->labels,
                                 gainInParam,
                                 "dB");
-    SimpleMBComp::addLabelPairs(lowMidXoverSlider->labels,
-                                lowMidParam,
-                                "Hz");
-    SimpleMBComp::addLabelPairs(midHighXoverSlider->labels,
-                                midHighParam,
-                                "Hz");
     SimpleMBComp::addLabelPairs(outGainSlider->labels,
                                 gainOutParam,
                                 "dB");
+    SimpleMBComp::addLabelPairs(lookaheadSlider->labels,
+                                lookaheadParam,
+                                "ms");
+    
+    numBandsSlider->labels.add({0.f, juce::String(MIN_BANDS)});
+    numBandsSlider->labels.add({1.f, juce::String(MAX_BANDS)});
+    
+    oversamplingSlider->labels.add({0.f, "1x"});
+    oversamplingSlider->labels.add({1.f, juce::String(1 << MAX_OVERSAMPLING_ORDER) + "x"});
+    
+    crossoverModeSlider->labels.add({0.f, "MIN"});
+    crossoverModeSlider->labels.add({1.f, "LIN"});
+    
+    stereoModeSlider->labels.add({0.f, "L/R"});
+    stereoModeSlider->labels.add({1.f, "M/S"});
+    
+    const auto& crossoverParams = GetCrossoverParams();
+    for( size_t i = 0; i < xoverSliders.size(); ++i )
+    {
+        auto& xoverParam = *apvts.getParameter(crossoverParams[i]);
+        
+        xoverSliders[i] = std::make_unique<RSWL>(&xoverParam,
+                                                 "Hz",
+                                                 "X-OVER " + juce::String(i + 1) + "-" + juce::String(i + 2));
+        
+        xoverSliderAttachments[i] = std::make_unique<Attachment>(apvts,
+                                                                 crossoverParams[i],
+                                                                 *xoverSliders[i]);
+        
+        SimpleMBComp::addLabelPairs(xoverSliders[i]->labels,
+                                    xoverParam,
+                                    "Hz");
+        
+        addChildComponent(*xoverSliders[i]);
+    }
     
     addAndMakeVisible(*inGainSlider);
-    addAndMakeVisible(*lowMidXoverSlider);
-    addAndMakeVisible(*midHighXoverSlider);
+    addAndMakeVisible(*numBandsSlider);
+    addAndMakeVisible(*oversamplingSlider);
+    addAndMakeVisible(*lookaheadSlider);
+    addAndMakeVisible(*crossoverModeSlider);
+    addAndMakeVisible(*stereoModeSlider);
     addAndMakeVisible(*outGainSlider);
 }
 
+void GlobalControls::setNumBands(size_t newNumBands)
+{
+    if( newNumBands == numBands )
+        return;
+    
+    numBands = newNumBands;
+    
+    for( size_t i = 0; i < xoverSliders.size(); ++i )
+    {
+        xoverSliders[i]->setVisible( i + 1 < numBands );
+    }
+    
+    resized();
+}
+
 void GlobalControls::paint(juce::Graphics &g)
 {
     auto bounds = getLocalBounds();
@@ -107,9 +177,23 @@ void GlobalControls::resized()
     flexBox.items.add(endCap);
     flexBox.items.add(FlexItem(*inGainSlider).withFlex(1.f));
     flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(*lowMidXoverSlider).withFlex(1.f));
+    flexBox.items.add(FlexItem(*numBandsSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*oversamplingSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*lookaheadSlider).withFlex(1.f));
     flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(*midHighXoverSlider).withFlex(1.f));
+    flexBox.items.add(FlexItem(*crossoverModeSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*stereoModeSlider).withFlex(1.f));
+    for( auto& xoverSlider : xoverSliders )
+    {
+        if( ! xoverSlider->isVisible() )
+            continue;
+        
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(*xoverSlider).withFlex(1.f));
+    }
     flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(*outGainSlider).withFlex(1.f));
     flexBox.items.add(endCap);
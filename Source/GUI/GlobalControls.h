@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 
 #include "RotarySliderWithLabels.h"
+#include "../DSP/Params.h"
 
 struct GlobalControls : juce::Component
 {
@@ -21,13 +22,25 @@ struct GlobalControls : juce::Component
     void paint(juce::Graphics& g) override;
     
     void resized() override;
+    
+    /*
+     only the crossovers used by 'numBands' bands are shown
+     */
+    void setNumBands(size_t numBands);
 private:
     using RSWL = RotarySliderWithLabels;
-    std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider;
+    std::unique_ptr<RSWL> inGainSlider, numBandsSlider, oversamplingSlider, lookaheadSlider, crossoverModeSlider, stereoModeSlider, outGainSlider;
+    std::array<std::unique_ptr<RSWL>, Params::MAX_CROSSOVERS> xoverSliders;
     
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    std::unique_ptr<Attachment> lowMidXoverSliderAttachment,
-                                midHighXoverSliderAttachment,
-                                inGainSliderAttachment,
+    std::unique_ptr<Attachment> inGainSliderAttachment,
+                                numBandsSliderAttachment,
+                                oversamplingSliderAttachment,
+                                lookaheadSliderAttachment,
+                                crossoverModeSliderAttachment,
+                                stereoModeSliderAttachment,
                                 outGainSliderAttachment;
+    std::array<std::unique_ptr<Attachment>, Params::MAX_CROSSOVERS> xoverSliderAttachments;
+    
+    size_t numBands { 0 };
 };
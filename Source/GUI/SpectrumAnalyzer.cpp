@@ -254,16 +254,10 @@ juce::Rectangle<int> SpectrumAnalyzerUtils::getAnalysisArea(juce::Rectangle<int>
     return bounds;
 }
 //==============================================================================
-MBCompAnalyzerOverlay::MBCompAnalyzerOverlay(juce::AudioParameterFloat& lowXover,
-                      juce::AudioParameterFloat& midXover,
-                      juce::AudioParameterFloat& lowThresh,
-                      juce::AudioParameterFloat& midThresh,
-                      juce::AudioParameterFloat& highThresh) :
-lowMidXoverParam(&lowXover),
-midHighXoverParam(&midXover),
-lowThresholdParam (&lowThresh),
-midThresholdParam (&midThresh),
-highThresholdParam(&highThresh)
+MBCompAnalyzerOverlay::MBCompAnalyzerOverlay(const CrossoverParams& xovers,
+                                             const ThresholdParams& thresholds) :
+crossoverParams(xovers),
+thresholdParams(thresholds)
 {
     
 }
@@ -276,38 +270,49 @@ void MBCompAnalyzerOverlay::drawCrossovers(juce::Graphics &g, juce::Rectangle<in
     const float top { static_cast<float>(bounds.getY()) };
     const float bottom { static_cast<float>(bounds.getBottom()) };
     
-    g.setColour(ColorScheme::getGainReductionColor().withAlpha(0.5f));
-    auto lowMidX = mapX(lowMidXoverParam->get(), bounds.toFloat());
-     
-    auto zeroDb = mapY(0.f, bottom, top);
+    /*
+     xs[i] is the left edge of band i, xs[i + 1] its right edge.
+     the crossovers are clamped the same way the processor clamps them.
+     */
+    std::array<float, Params::MAX_BANDS + 1> xs {};
+    xs[0] = static_cast<float>(bounds.getX());
+    auto lowerLimit = MIN_FREQUENCY;
+    for( size_t i = 0; i + 1 < numBands; ++i )
+    {
+        lowerLimit = jmax(crossoverParams[i]->get(), lowerLimit);
+        xs[i + 1] = mapX(lowerLimit, bounds.toFloat());
+    }
+    xs[numBands] = static_cast<float>(bounds.getRight());
     
-    g.fillRect(Rectangle<float>::leftTopRightBottom(bounds.getX(),
-                                                    zeroDb,
-                                                    lowMidX,
-                                                    mapY(lowBandGR, bottom, top)));
+    g.setColour(ColorScheme::getGainReductionColor().withAlpha(0.25f));
     
-    auto midHighX = mapX(midHighXoverParam->get(), bounds.toFloat());
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX,
-                                                    zeroDb,
-                                                    midHighX,
-                                                    mapY(midBandGR, bottom, top)));
+    auto zeroDb = mapY(0.f, bottom, top);
     
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX,
-                                                    zeroDb,
-                                                    bounds.getRight(),
-                                                    mapY(highBandGR, bottom, top)));
+    for( size_t i = 0; i < numBands; ++i )
+    {
+        g.fillRect(Rectangle<float>::leftTopRightBottom(xs[i],
+                                                        zeroDb,
+                                                        xs[i + 1],
+                                                        mapY(bandGR[i], bottom, top)));
+    }
     
-    g.setColour(Colours::lightblue);
-    g.drawVerticalLine(static_cast<int>(lowMidX), top, bottom);
-    g.drawVerticalLine(static_cast<int>(midHighX), top, bottom);
+    /*
+     the history on top of the last block's gain reduction
+     */
+    g.setColour(ColorScheme::getGainReductionColor().withAlpha(0.75f));
+    for( size_t i = 0; i < numBands; ++i )
+    {
+        drawHistory(g, i, xs[i], xs[i + 1], bottom, top);
+    }
     
-    g.setColour(ColorScheme::getThresholdColor());
     /*
      draw crossovers after GR rectangles
      */
     g.setColour(Colours::lightblue);
-    g.drawVerticalLine(static_cast<int>(lowMidX), top, bottom);
-    g.drawVerticalLine(static_cast<int>(midHighX), top, bottom);
+    for( size_t i = 1; i < numBands; ++i )
+    {
+        g.drawVerticalLine(static_cast<int>(xs[i]), top, bottom);
+    }
     
     g.setColour(ColorScheme::getThresholdColor());
     auto drawThreshold = [&g](auto left, auto right, auto top_, auto bottom_)
@@ -315,35 +320,73 @@ void MBCompAnalyzerOverlay::drawCrossovers(juce::Graphics &g, juce::Rectangle<in
         g.fillRect(Rectangle<float>::leftTopRightBottom(left, top_, right, bottom_));
     };
     
-    auto lowTh = mapY(lowThresholdParam->get(), bottom, top);
-    auto midTh = mapY(midThresholdParam->get(), bottom, top);
-    auto highTh = mapY(highThresholdParam->get(), bottom, top);
-    
     auto offset = 1; //JUCE_LIVE_CONSTANT(2);
     
-    drawThreshold(bounds.getX(), lowMidX, lowTh - offset, lowTh + offset);
-    drawThreshold(lowMidX, midHighX, midTh - offset, midTh + offset);
-    drawThreshold(midHighX, bounds.getRight(), highTh - offset, highTh + offset);
+    for( size_t i = 0; i < numBands; ++i )
+    {
+        auto th = mapY(thresholdParams[i]->get(), bottom, top);
+        drawThreshold(xs[i], xs[i + 1], th - offset, th + offset);
+    }
 }
 
-void MBCompAnalyzerOverlay::update(const std::vector<float> &values)
+void MBCompAnalyzerOverlay::update(const MeterFrame& frame)
 {
-    jassert(values.size() == 6);
+    for( size_t i = 0; i < frame.numBands; ++i )
+    {
+        auto reductionDb = frame.bands[i].gainReductionDb;
+        if( frame.isMidSide )
+            reductionDb = juce::jmax(reductionDb, frame.sideBands[i].gainReductionDb);
+        
+        //drawn downwards from 0 dB
+        bandGR[i] = -reductionDb;
+    }
     
-    enum
+    repaint();
+}
+
+void MBCompAnalyzerOverlay::addToHistory(const GainReductionPoint& point)
+{
+    for( size_t i = 0; i < point.numBands; ++i )
     {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
-    };
+        auto range = point.bands[i];
+        if( point.isMidSide )
+            range.merge(point.sideBands[i]);
+        
+        history[i][historyWriteIndex] = range;
+    }
+    
+    historyWriteIndex = (historyWriteIndex + 1) % HISTORY_SIZE;
+    repaint();
+}
+
+void MBCompAnalyzerOverlay::drawHistory(juce::Graphics& g, size_t band, float left, float right, float bottom, float top)
+{
+    /*
+     the least reduction is the upper edge, the most the lower one.
+     historyWriteIndex is the oldest point, the one before it the newest.
+     */
+    const auto& points = history[band];
+    const auto step = (right - left) / static_cast<float>(HISTORY_SIZE - 1);
+    auto pointAt = [&](size_t i) -> const GainReductionRange& { return points[(historyWriteIndex + i) % HISTORY_SIZE]; };
     
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
+    juce::Path path;
+    path.startNewSubPath(left, mapY(-pointAt(0).minDb, bottom, top));
+    for( size_t i = 1; i < HISTORY_SIZE; ++i )
+        path.lineTo(left + step * static_cast<float>(i), mapY(-pointAt(i).minDb, bottom, top));
+    
+    for( size_t i = HISTORY_SIZE; i-- > 0; )
+        path.lineTo(left + step * static_cast<float>(i), mapY(-pointAt(i).maxDb, bottom, top));
+    
+    path.closeSubPath();
+    g.fillPath(path);
+}
+
+void MBCompAnalyzerOverlay::setNumBands(size_t newNumBands)
+{
+    if( newNumBands == numBands )
+        return;
     
+    numBands = newNumBands;
     repaint();
 }
 
@@ -13,6 +13,9 @@
 #include <JuceHeader.h>
 
 #include "PathProducer.h"
+#include "../DSP/GainReductionHistory.h"
+#include "../DSP/LevelMeter.h"
+#include "../DSP/Params.h"
 
 namespace SimpleMBComp
 {
@@ -62,32 +65,45 @@ private:
 
 struct MBCompAnalyzerOverlay : juce::Component, juce::Timer
 {
-    MBCompAnalyzerOverlay(juce::AudioParameterFloat& lowXover,
-                          juce::AudioParameterFloat& midXover,
-                          juce::AudioParameterFloat& lowThresh,
-                          juce::AudioParameterFloat& midThresh,
-                          juce::AudioParameterFloat& highThresh);
-                            
+    using CrossoverParams = std::array<juce::AudioParameterFloat*, Params::MAX_CROSSOVERS>;
+    using ThresholdParams = std::array<juce::AudioParameterFloat*, Params::MAX_BANDS>;
+    
+    MBCompAnalyzerOverlay(const CrossoverParams& xovers,
+                          const ThresholdParams& thresholds);
+    
     void drawCrossovers(juce::Graphics& g,
                         juce::Rectangle<int> bounds);
     
+    /*
+     shows the gain reduction of every band in 'frame'.
+     in mid/side mode a band shows whichever of its mid and side is reduced more.
+     */
+    void update(const MeterFrame& frame);
     
-    void update(const std::vector<float>& values);
+    /*
+     appends 'point' to every band's gain reduction history.
+     each band draws its history across its own width, oldest on the left.
+     */
+    void addToHistory(const GainReductionPoint& point);
+    
+    void setNumBands(size_t newNumBands);
     
     void paint(juce::Graphics& g) override;
     
     void timerCallback() override;
     
-    juce::AudioParameterFloat* lowMidXoverParam { nullptr };
-    juce::AudioParameterFloat* midHighXoverParam { nullptr };
+    CrossoverParams crossoverParams;
+    ThresholdParams thresholdParams;
+    
+    std::array<float, Params::MAX_BANDS> bandGR {};
     
-    juce::AudioParameterFloat* lowThresholdParam { nullptr };
-    juce::AudioParameterFloat* midThresholdParam { nullptr };
-    juce::AudioParameterFloat* highThresholdParam { nullptr };
+    //a bit over a second at GAIN_REDUCTION_POINTS_PER_SECOND
+    static constexpr size_t HISTORY_SIZE = 256;
+    std::array<std::array<GainReductionRange, HISTORY_SIZE>, Params::MAX_BANDS> history {};
+    size_t historyWriteIndex { 0 };
     
-    float lowBandGR { 0.f };
-    float midBandGR { 0.f };
-    float highBandGR { 0.f };
+    void drawHistory(juce::Graphics& g, size_t band, float left, float right, float bottom, float top);
+    size_t numBands { Params::MIN_BANDS };
 };
 
 } //end namespace SimpleMBComp
@@ -52,16 +52,21 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
     addAndMakeVisible(controlBar);
     addAndMakeVisible(analyzer);
     
-    overlay = std::make_unique<SimpleMBComp::MBCompAnalyzerOverlay>(*audioProcessor.lowMidCrossover,
-                                                      *audioProcessor.midHighCrossover,
-                                                      *audioProcessor.lowThresholdParam,
-                                                      *audioProcessor.midThresholdParam,
-                                                      *audioProcessor.highThresholdParam);
+    SimpleMBComp::MBCompAnalyzerOverlay::ThresholdParams thresholds;
+    for( size_t i = 0; i < thresholds.size(); ++i )
+    {
+        thresholds[i] = audioProcessor.compressors[i].threshold;
+    }
+    
+    overlay = std::make_unique<SimpleMBComp::MBCompAnalyzerOverlay>(audioProcessor.crossovers,
+                                                                    thresholds);
     addAndMakeVisible(*overlay);
     
     addAndMakeVisible(globalControls);
     addAndMakeVisible(bandControls);
     
+    updateNumBands();
+    
     setSize (600, 500);
     
     startTimerHz(60);
@@ -152,21 +157,35 @@ void SimpleMBCompAudioProcessorEditor::resized()
 
 void SimpleMBCompAudioProcessorEditor::timerCallback()
 {
-    std::vector<float> values
-    {
-        audioProcessor.lowBandComp.getRMSInputLevelDb(),
-        audioProcessor.lowBandComp.getRMSOutputLevelDb(),
-        audioProcessor.midBandComp.getRMSInputLevelDb(),
-        audioProcessor.midBandComp.getRMSOutputLevelDb(),
-        audioProcessor.highBandComp.getRMSInputLevelDb(),
-        audioProcessor.highBandComp.getRMSOutputLevelDb()
-    };
+    updateNumBands();
+    bandControls.setMidSide(audioProcessor.stereoModeParam->getIndex() == Params::StereoModes::Mid_Side);
+    
+    //only the newest frame is shown, the ones that came in since the last tick are skipped
+    SimpleMBComp::MeterFrame frame;
+    auto hasNewFrame = false;
+    while( audioProcessor.meterFrames.pull(frame) )
+        hasNewFrame = true;
+    
+    if( hasNewFrame )
+        overlay->update(frame);
     
-    overlay->update(values);
+    //the gain reduction history doesn't skip anything, every point since the last tick is drawn
+    SimpleMBComp::GainReductionPoint point;
+    while( audioProcessor.gainReductionHistory.pull(point) )
+        overlay->addToHistory(point);
     
     updateGlobalBypassButton();
 }
 
+void SimpleMBCompAudioProcessorEditor::updateNumBands()
+{
+    auto numBands = audioProcessor.getNumBands();
+    
+    globalControls.setNumBands(numBands);
+    bandControls.setNumBands(numBands);
+    overlay->setNumBands(numBands);
+}
+
 void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
 {
     auto params = getBypassParams();
@@ -200,29 +219,16 @@ void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
     bandControls.toggleAllBands(! shouldEnableEverything);
 }
 
-std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
+std::vector<juce::AudioParameterBool*> SimpleMBCompAudioProcessorEditor::getBypassParams()
 {
-    using namespace Params;
-    using namespace juce;
-    const auto& params = Params::GetParams();
-    auto& apvts = audioProcessor.apvts;
-    
-    auto boolHelper = [&apvts, &params](const auto& paramName)
+    std::vector<juce::AudioParameterBool*> params;
+    for( size_t i = 0; i < audioProcessor.getNumBands(); ++i )
     {
-        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
+        auto* param = audioProcessor.compressors[i].bypassed;
         jassert(param != nullptr);
         
-        return param;
-    };
-    
-    auto* lowBypassParam = boolHelper(Names::Bypassed_Low_Band);
-    auto* midBypassParam = boolHelper(Names::Bypassed_Mid_Band);
-    auto* highBypassParam = boolHelper(Names::Bypassed_High_Band);
+        params.push_back(param);
+    }
     
-    return
-    {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
-    };
+    return params;
 }
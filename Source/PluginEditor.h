@@ -60,9 +60,11 @@ private:
     
     void toggleGlobalBypassState();
     
-    std::array<juce::AudioParameterBool*, 3> getBypassParams();
+    std::vector<juce::AudioParameterBool*> getBypassParams();
     
     void updateGlobalBypassButton();
 
+    void updateNumBands();
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
 };
@@ -17,85 +17,83 @@ SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
                        )
 #endif
 {
+    //picks the DSP kernels for this CPU here, so the first processBlock doesn't have to
+    SimpleMBComp::Kernels::getActiveKernels();
+    
     using namespace Params;
     const auto& params = GetParams();
     
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    auto floatHelper = [&apvts = this->apvts](auto& param, const auto& paramName)
     {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
     
-    floatHelper(lowBandComp.attack, Names::Attack_Low_Band);
-    floatHelper(lowBandComp.release, Names::Release_Low_Band);
-    floatHelper(lowBandComp.threshold, Names::Threshold_Low_Band);
-    
-    floatHelper(midBandComp.attack,     Names::Attack_Mid_Band);
-    floatHelper(midBandComp.release,    Names::Release_Mid_Band);
-    floatHelper(midBandComp.threshold,  Names::Threshold_Mid_Band);
-    
-    floatHelper(highBandComp.attack,    Names::Attack_High_Band);
-    floatHelper(highBandComp.release,   Names::Release_High_Band);
-    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
-    
-    lowThresholdParam = lowBandComp.threshold;
-    midThresholdParam = midBandComp.threshold;
-    highThresholdParam = highBandComp.threshold;
-    
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    auto choiceHelper = [&apvts = this->apvts](auto& param, const auto& paramName)
     {
-        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
+        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
     
-    choiceHelper(lowBandComp.ratio, Names::Ratio_Low_Band);
-    choiceHelper(midBandComp.ratio, Names::Ratio_Mid_Band);
-    choiceHelper(highBandComp.ratio, Names::Ratio_High_Band);
-    
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    auto boolHelper = [&apvts = this->apvts](auto& param, const auto& paramName)
     {
-        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
+        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
     
-    boolHelper(lowBandComp.bypassed, Names::Bypassed_Low_Band);
-    boolHelper(midBandComp.bypassed, Names::Bypassed_Mid_Band);
-    boolHelper(highBandComp.bypassed, Names::Bypassed_High_Band);
-    
-    boolHelper(lowBandComp.mute, Names::Mute_Low_Band);
-    boolHelper(midBandComp.mute, Names::Mute_Mid_Band);
-    boolHelper(highBandComp.mute, Names::Mute_High_Band);
-    
-    boolHelper(lowBandComp.solo, Names::Solo_Low_Band);
-    boolHelper(midBandComp.solo, Names::Solo_Mid_Band);
-    boolHelper(highBandComp.solo, Names::Solo_High_Band);
-    
-    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
+    auto bandHelper = [&](auto& comps, const auto& bandParams)
+    {
+        for( size_t band = 0; band < comps.size(); ++band )
+        {
+            auto& comp = comps[band];
+            const auto& names = bandParams[band];
+        
+            floatHelper(comp.attack,    names.at(BandNames::Attack));
+            floatHelper(comp.release,   names.at(BandNames::Release));
+            floatHelper(comp.threshold, names.at(BandNames::Threshold));
+            floatHelper(comp.knee,      names.at(BandNames::Knee));
+        
+            choiceHelper(comp.ratio, names.at(BandNames::Ratio));
+        
+            boolHelper(comp.bypassed, names.at(BandNames::Bypassed));
+            boolHelper(comp.mute,     names.at(BandNames::Mute));
+            boolHelper(comp.solo,     names.at(BandNames::Solo));
+            boolHelper(comp.sidechain, names.at(BandNames::Sidechain));
+        }
+    };
     
-    floatHelper(inputGainParam, Names::Gain_In);
-    floatHelper(outputGainParam, Names::Gain_Out);
+    bandHelper(compressors, GetBandParams());
+    bandHelper(sideCompressors, GetSideBandParams());
     
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    const auto& crossoverParams = GetCrossoverParams();
+    for( size_t i = 0; i < crossovers.size(); ++i )
+    {
+        floatHelper(crossovers[i], crossoverParams[i]);
+    }
     
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    choiceHelper(numBandsParam, params.at(Names::Number_Of_Bands));
+    choiceHelper(oversamplingParam, params.at(Names::Oversampling));
+    floatHelper(lookaheadParam, params.at(Names::Lookahead));
+    choiceHelper(crossoverModeParam, params.at(Names::Crossover_Mode));
+    choiceHelper(stereoModeParam, params.at(Names::Stereo_Mode));
     
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    floatHelper(inputGainParam, params.at(Names::Gain_In));
+    floatHelper(outputGainParam, params.at(Names::Gain_Out));
     
-//    invAP1.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-//    invAP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    //see timerCallback()
+    startTimerHz(30);
 }
 
 SimpleMBCompAudioProcessor::~SimpleMBCompAudioProcessor()
 {
+    stopTimer();
 }
 
 //==============================================================================
@@ -131,9 +129,32 @@ bool SimpleMBCompAudioProcessor::isMidiEffect() const
    #endif
 }
 
+/*
+ once the input stops, the output holds the latency's worth of audio, then the crossovers ring out.
+ the envelopes keep falling back to 0 dB for a few of the slowest release times after that,
+ a host that suspends the plugin any earlier would resume it with gain reduction left over.
+ */
+static constexpr double FILTER_RING_SECONDS = 0.2;
+//within 1% of 0 dB after this many release times
+static constexpr double RELEASE_TIME_CONSTANTS = 5.0;
+
+/*
+ the host is told the tail for the longest release the parameter allows.
+ following the release in use would have to tell the host every time one moves,
+ and the only way to do that is a latency change, which some hosts restart the plugin for.
+ */
 double SimpleMBCompAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return getTailSeconds(compressors[0].release->range.end);
+}
+
+//the idle check uses the releases in use
+double SimpleMBCompAudioProcessor::getTailSeconds(float longestReleaseMs) const
+{
+    auto sampleRate = getSampleRate();
+    auto latencySeconds = sampleRate > 0.0 ? latencyInSamples.load() / sampleRate : 0.0;
+    
+    return latencySeconds + FILTER_RING_SECONDS + RELEASE_TIME_CONSTANTS * longestReleaseMs / 1000.0;
 }
 
 int SimpleMBCompAudioProcessor::getNumPrograms()
@@ -168,38 +189,86 @@ void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
     
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
+    spec.numChannels = static_cast<juce::uint32>(getMainBusNumOutputChannels());
     spec.sampleRate = sampleRate;
     
-    for( auto& comp : compressors )
-        comp.prepare(spec);
+    /*
+     the bands only ever see one tile at a time.
+     apart from whether the bands may run in parallel nothing here depends on samplesPerBlock,
+     so blocks longer than announced, or of a different length every time, never allocate.
+     */
+    auto tileSpec = spec;
+    tileSpec.maximumBlockSize = static_cast<juce::uint32>(SimpleMBComp::TILE_SIZE);
     
-    LP1.prepare(spec);
-    HP1.prepare(spec);
+    maxLookaheadSamples = static_cast<size_t>(std::ceil(sampleRate * Params::MAX_LOOKAHEAD_MS / 1000.0));
     
-    AP2.prepare(spec);
+    //the band buffers hold a whole chunk when the bands may be compressed in parallel
+    if( parallelBandsEnabled && static_cast<size_t>(samplesPerBlock) >= SimpleMBComp::PARALLEL_CHUNK_SIZE )
+    {
+        if( bandWorkers == nullptr )
+            bandWorkers = std::make_unique<juce::SharedResourcePointer<SimpleMBComp::BandWorkerPool>>();
+    }
+    else
+    {
+        bandWorkers.reset();
+    }
     
-    LP2.prepare(spec);
-    HP2.prepare(spec);
+    auto parameters = readParameters();
     
-//    invAP1.prepare(spec);
-//    invAP2.prepare(spec);
-//
-//    invAPBuffer.setSize(spec.numChannels, samplesPerBlock);
+    /*
+     the linear-phase splitter only takes up memory and a thread once it is asked for.
+     in linear phase mode it is prepared right away, so the first blocks don't wait for the designer thread.
+     */
+    linearPhaseSpec = spec;
+    if( parameters.linearPhase )
+    {
+        linearPhaseCrossovers.setCrossovers(parameters.crossovers, parameters.numBands);
+        linearPhaseCrossovers.prepare(spec);
+    }
+    else
+    {
+        linearPhaseCrossovers.release();
+    }
     
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
+    if( isUsingDoublePrecision() )
+        prepareBands<double>(tileSpec);
+    else
+        prepareBands<float>(tileSpec);
     
-    inputGain.setRampDurationSeconds(0.05); //50 ms
-    outputGain.setRampDurationSeconds(0.05);
+    for( auto& engine : engines )
+        engine->prepare(tileSpec);
     
-    for( auto& buffer : filterBuffers )
+    activeEngine = nullptr;
+    
+    oversamplingOrder.update(parameters.oversamplingOrder);
+    lookaheadMs.update(parameters.lookaheadMs);
+    linearPhase.update(parameters.linearPhase);
+    midSide.update(parameters.midSide);
+    applyLatencySettings();
+    
+    setLatencySamples(latencyInSamples);
+    
+    auto prepareGains = [&spec](auto& gains)
     {
-        buffer.setSize(static_cast<int>(spec.numChannels), samplesPerBlock);
-    }
+        for( auto* gain : { &gains.input, &gains.output } )
+        {
+            gain->prepare(spec);
+            gain->setRampDurationSeconds(0.05); //50 ms
+        }
+    };
+    
+    prepareGains(floatGains);
+    prepareGains(doubleGains);
+    
+    const auto analyzedChannels = getChannelLayoutOfBus(true, 0);
+    leftChannelFifo.prepare(SimpleMBComp::ANALYZER_BLOCK_SIZE, analyzedChannels);
+    rightChannelFifo.prepare(SimpleMBComp::ANALYZER_BLOCK_SIZE, analyzedChannels);
     
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    gainReductionDecimator.prepare(sampleRate);
+    
+    //everything above starts from silence, the input has to be silent for a whole tail again
+    silentSamples = 0;
+    idle = false;
     
 #if USE_TEST_OSC
     osc.initialise([](float x){ return std::sin(x); });
@@ -212,10 +281,66 @@ void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 #endif
 }
 
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::prepareBands(const juce::dsp::ProcessSpec& tileSpec)
+{
+    //the side compressors are prepared even for buses without a side, they are simply never used there
+    for( auto* comps : { &compressors, &sideCompressors } )
+    {
+        for( auto& comp : *comps )
+            comp.prepare<SampleType>(tileSpec);
+    }
+    
+    /*
+     rows for every channel of every band and side band, long enough for the longest lookahead.
+     the bands delay at the host rate whatever their oversampling order, changing the lookahead later on only changes how far back they read.
+     */
+    auto& lookaheadDelay = [this]() -> auto&
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleLookaheadDelay;
+        else
+            return floatLookaheadDelay;
+    }();
+    
+    lookaheadDelay.prepare(2 * compressors.size() * tileSpec.numChannels, maxLookaheadSamples);
+    
+    for( size_t band = 0; band < compressors.size(); ++band )
+    {
+        compressors[band].setDelayLine(lookaheadDelay, band * tileSpec.numChannels);
+        sideCompressors[band].setDelayLine(lookaheadDelay, (compressors.size() + band) * tileSpec.numChannels);
+    }
+    
+    const auto bandBufferSize = static_cast<int>(bandWorkers != nullptr ? SimpleMBComp::PARALLEL_CHUNK_SIZE : tileSpec.maximumBlockSize);
+    for( auto& buffer : filterBuffers.get<SampleType>() )
+    {
+        buffer.setSize(static_cast<int>(tileSpec.numChannels), bandBufferSize);
+    }
+    
+    /*
+     the key is spread across as many channels as the main bus has, one tile or chunk at a time.
+     in linear phase mode it is delayed to line up with the bands before it is split.
+     */
+    auto& keys = getKeys<SampleType>();
+    auto hasSidechain = getChannelCountOfBus(true, 1) > 0;
+    auto keyChannels = hasSidechain ? static_cast<int>(tileSpec.numChannels) : 0;
+    
+    keys.tile.setSize(keyChannels, bandBufferSize);
+    const auto maxKeyDelay = SimpleMBComp::LinearPhaseCrossovers::getLatencyInSamples(tileSpec.sampleRate);
+    keys.delay.prepare(static_cast<size_t>(keyChannels), hasSidechain ? static_cast<size_t>(maxKeyDelay) : 0);
+    
+    for( auto& buffer : filterBuffers.getKeys<SampleType>() )
+    {
+        buffer.setSize(keyChannels, bandBufferSize);
+    }
+}
+
 void SimpleMBCompAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    linearPhaseSpec = {};
+    linearPhaseCrossovers.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -225,13 +350,25 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout is supported, discrete, surround or ambisonic,
+    // up to MAX_CHANNELS channels.
+    const auto& mainOutput = layouts.getMainOutputChannelSet();
+    if (mainOutput.isDisabled()
+     || mainOutput.size() > static_cast<int>(Params::MAX_CHANNELS))
         return false;
+    
+    // The sidechain is optional. A mono key drives every channel,
+    // a wider one has to match the main bus channel for channel.
+   #if ! JucePlugin_IsSynth
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto& sidechain = layouts.getChannelSet(true, 1);
+        if (! sidechain.isDisabled()
+         && sidechain.size() != 1
+         && sidechain.size() != mainOutput.size())
+            return false;
+    }
+   #endif
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
@@ -244,52 +381,166 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 }
 #endif
 
-void SimpleMBCompAudioProcessor::updateState()
+size_t SimpleMBCompAudioProcessor::getNumBands() const
 {
-    for( auto& compressor : compressors )
-        compressor.updateCompressorSettings();
-    
-    auto lowMidCutoffFreq = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoffFreq);
-    HP1.setCutoffFrequency(lowMidCutoffFreq);
+    return Params::MIN_BANDS + static_cast<size_t>(numBandsParam->getIndex());
+}
+
+SimpleMBComp::ProcessingSnapshot SimpleMBCompAudioProcessor::readParameters() const
+{
+    SimpleMBComp::ProcessingSnapshot parameters;
+    parameters.numBands = getNumBands();
+    
+    //mid/side only exists for stereo buses
+    parameters.midSide = stereoModeParam->getIndex() == Params::StereoModes::Mid_Side
+                      && getMainBusNumOutputChannels() == 2;
+    parameters.linearPhase = crossoverModeParam->getIndex() == Params::CrossoverModes::Linear_Phase;
+    parameters.oversamplingOrder = oversamplingParam->getIndex();
+    parameters.lookaheadMs = lookaheadParam->get();
+    parameters.inputGainDb = inputGainParam->get();
+    parameters.outputGainDb = outputGainParam->get();
+    
+    auto lowerLimit = SimpleMBComp::MIN_FREQUENCY;
+    for( size_t i = 0; i < parameters.numBands - 1; ++i )
+    {
+        //crossovers are not allowed to pass the one below them
+        parameters.crossovers[i] = juce::jmax(crossovers[i]->get(), lowerLimit);
+        lowerLimit = parameters.crossovers[i];
+    }
     
-    auto midHighCutoffFreq = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoffFreq);
-    LP2.setCutoffFrequency(midHighCutoffFreq);
-    HP2.setCutoffFrequency(midHighCutoffFreq);
+    parameters.readBands(compressors, sideCompressors);
     
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
+    return parameters;
 }
 
-void SimpleMBCompAudioProcessor::splitBands(const juce::AudioBuffer<float> &inputBuffer)
+void SimpleMBCompAudioProcessor::updateState()
 {
-    for( auto& fb : filterBuffers )
+    auto numBands = snapshot.numBands;
+    
+    /*
+     switching to linear phase while playing has the message thread prepare the splitter,
+     the audio thread can't allocate it.  until that is done the bands stay on the minimum-phase crossovers.
+     */
+    if( snapshot.linearPhase && ! linearPhaseCrossovers.isPrepared() )
     {
-        fb = inputBuffer;
+        linearPhaseCrossovers.setCrossovers(snapshot.crossovers, numBands);
+        snapshot.linearPhase = false;
+        linearPhaseRequested = true;
     }
     
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+    auto* engine = engines[numBands - Params::MIN_BANDS].get();
+    if( engine != activeEngine )
+    {
+        //this engine's filters hold state from the last time it was used
+        engine->reset();
+        activeEngine = engine;
+    }
     
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+    for( size_t i = 0; i < numBands; ++i )
+    {
+        compressors[i].updateCompressorSettings(snapshot.bands[i]);
+        if( snapshot.midSide )
+            sideCompressors[i].updateCompressorSettings(snapshot.sideBands[i]);
+    }
     
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
+    //all of them have to be checked, || would skip the later updates
+    auto oversamplingChanged = oversamplingOrder.update(snapshot.oversamplingOrder);
+    auto lookaheadChanged = lookaheadMs.update(snapshot.lookaheadMs);
+    auto crossoverModeChanged = linearPhase.update(snapshot.linearPhase);
+    auto stereoModeChanged = midSide.update(snapshot.midSide);
+    if( stereoModeChanged )
+    {
+        /*
+         every filter, envelope and lookahead row holds audio in the other encoding.
+         that includes the side bands, which weren't even updated while they were out of use.
+         */
+        resetDSP();
+    }
+    else if( crossoverModeChanged )
+    {
+        //whichever splitter takes over holds state from the last time it was used
+        activeEngine->reset();
+        linearPhaseCrossovers.reset();
+        floatKeys.delay.reset();
+        doubleKeys.delay.reset();
+    }
+    
+    //without a band listening to it, the key isn't even copied
+    usesSidechain = snapshot.isSetForAnyBand(&CompressorBand::Settings::sidechain);
+    
+    if( oversamplingChanged || lookaheadChanged || crossoverModeChanged )
+        applyLatencySettings();
     
-    HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
-    LP2.process(fb1Ctx);
+    activeEngine->updateState(snapshot);
     
-    HP2.process(fb2Ctx);
+    if( inputGainDb.update(snapshot.inputGainDb) )
+    {
+        floatGains.input.setGainDecibels(inputGainDb.get());
+        doubleGains.input.setGainDecibels(inputGainDb.get());
+    }
+    
+    if( outputGainDb.update(snapshot.outputGainDb) )
+    {
+        floatGains.output.setGainDecibels(outputGainDb.get());
+        doubleGains.output.setGainDecibels(outputGainDb.get());
+    }
+}
+
+size_t SimpleMBCompAudioProcessor::getLookaheadSamples() const
+{
+    auto numSamples = static_cast<size_t>(juce::roundToInt(getSampleRate() * lookaheadMs.get() / 1000.0));
+    
+    //rounding up at the highest sample rates must not read past the end of the delay line
+    return juce::jmin(numSamples, maxLookaheadSamples);
+}
+
+void SimpleMBCompAudioProcessor::applyLatencySettings()
+{
+    auto lookahead = getLookaheadSamples();
+    for( auto* comps : { &compressors, &sideCompressors } )
+    {
+        for( auto& comp : *comps )
+        {
+            comp.setOversamplingOrder(static_cast<size_t>(oversamplingOrder.get()));
+            comp.setLookaheadSamples(lookahead);
+        }
+    }
+    
+    latencyInSamples = juce::roundToInt(compressors[0].getLatencyInSamples())
+                     + (linearPhase.get() ? linearPhaseCrossovers.getLatencyInSamples() : 0);
+}
+
+void SimpleMBCompAudioProcessor::timerCallback()
+{
+    //asked for by updateState(), the audio thread picks it up once it is prepared
+    if( linearPhaseRequested.exchange(false)
+       && crossoverModeParam->getIndex() == Params::CrossoverModes::Linear_Phase
+       && ! linearPhaseCrossovers.isPrepared()
+       && linearPhaseSpec.sampleRate > 0.0 )
+    {
+        linearPhaseCrossovers.prepare(linearPhaseSpec);
+    }
+    
+    //only tells the host when it actually changed
+    setLatencySamples(latencyInSamples);
 }
 
 void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                                juce::MidiBuffer& /*midiMessages*/)
 {
+    process(buffer);
+}
+
+void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer,
+                                               juce::MidiBuffer& /*midiMessages*/)
+{
+    process(buffer);
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    SimpleMBComp::RealtimeSafety::ScopedRealtimeSection realtimeSection { __FILE__, __LINE__ };
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -303,9 +554,12 @@ void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
+    //the only place the audio thread reads the parameters, every stage below uses the snapshot
+    snapshot = readParameters();
     updateState();
     
 #if USE_TEST_OSC
+    if constexpr( std::is_same_v<SampleType, float> )
     {
         buffer.clear();
         auto block = juce::dsp::AudioBlock<float>(buffer);
@@ -317,66 +571,171 @@ void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
 #endif
     
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    //the sidechain channels follow the main ones in 'buffer', only the main bus is processed
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    auto sidechainBuffer = getBusBuffer(buffer, true, 1);
     
-    applyGain(buffer, inputGain);
-
-    splitBands(buffer);
+    //a key the bands listen to can still move the envelopes while the main input is silent
+    const auto isInputSilent = isSilent(mainBuffer) && (! usesSidechain || isSilent(sidechainBuffer));
+    silentSamples = isInputSilent ? silentSamples + static_cast<size_t>(buffer.getNumSamples()) : 0;
     
-    for( size_t i = 0; i < filterBuffers.size(); ++i )
+    if( idle )
     {
-        compressors[i].process(filterBuffers[i]);
+        if( isInputSilent )
+        {
+            mainBuffer.clear();
+            
+            //the history keeps scrolling, showing no gain reduction
+            SimpleMBComp::GainReductionPoint silentPoint;
+            silentPoint.numBands = activeEngine->getNumBands();
+            silentPoint.isMidSide = midSide.get();
+            gainReductionDecimator.add(silentPoint, static_cast<size_t>(buffer.getNumSamples()), gainReductionHistory);
+            return;
+        }
+        
+        //everything was reset on the way in, so it starts from silence just like a fresh instance
+        idle = false;
     }
     
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
-    
-    buffer.clear();
+    leftChannelFifo.update(mainBuffer);
+    rightChannelFifo.update(mainBuffer);
+    
+    auto& keys = getKeys<SampleType>();
+    const auto isKeyed = usesSidechain
+                      && sidechainBuffer.getNumChannels() > 0
+                      && keys.tile.getNumChannels() == mainBuffer.getNumChannels();
+    
+    /*
+     input gain, split, compression, summing and output gain all run on one tile
+     before the next tile is touched, instead of each making its own pass over the buffer.
+     long blocks go a chunk of tiles at a time instead, so the bands can be compressed in parallel.
+     */
+    auto& gains = getGains<SampleType>();
+    auto block = juce::dsp::AudioBlock<SampleType>(mainBuffer);
+    const auto numSamples = block.getNumSamples();
+    auto* workers = bandWorkers != nullptr && numSamples >= SimpleMBComp::PARALLEL_CHUNK_SIZE ? &bandWorkers->get() : nullptr;
+    const auto stride = workers != nullptr ? SimpleMBComp::PARALLEL_CHUNK_SIZE : SimpleMBComp::TILE_SIZE;
+    for( size_t start = 0; start < numSamples; start += stride )
+    {
+        auto tile = block.getSubBlock(start, juce::jmin(stride, numSamples - start));
+
+        auto key = juce::dsp::AudioBlock<SampleType>();
+        if( isKeyed )
+            key = getKeyTile(sidechainBuffer, start, tile.getNumSamples());
+        
+        applyGain(tile, gains.input);
+        if( workers != nullptr )
+            activeEngine->process(tile, key, *workers);
+        else
+            activeEngine->process(tile, key);
+        applyGain(tile, gains.output);
+        
+        trackGainReduction(tile.getNumSamples());
+    }
     
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
+    //every band's levels from this block go out together
+    SimpleMBComp::MeterFrame frame;
+    frame.numBands = activeEngine->getNumBands();
+    frame.isMidSide = midSide.get();
+    for( size_t i = 0; i < frame.numBands; ++i )
     {
-        for( auto i = 0; i < nc; ++i )
-        {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        }
-    };
+        frame.bands[i] = compressors[i].takeLevels();
+        if( frame.isMidSide )
+            frame.sideBands[i] = sideCompressors[i].takeLevels();
+    }
     
-    auto bandsAreSoloed = false;
-    for( auto& comp : compressors)
+    //when the editor isn't pulling them, the frame is simply dropped
+    meterFrames.push(frame);
+    
+    if( idleEnabled && static_cast<double>(silentSamples) > getTailSeconds(snapshot.getLongestReleaseMs()) * getSampleRate() )
     {
-        if( comp.solo->get() )
+        resetDSP();
+        idle = true;
+        
+        //no frames are pushed while idle, the meters would stay on this block's levels otherwise
+        SimpleMBComp::MeterFrame silentFrame;
+        silentFrame.numBands = frame.numBands;
+        silentFrame.isMidSide = frame.isMidSide;
+        meterFrames.push(silentFrame);
+    }
+}
+
+/*
+ about -160 dB, far below anything the bands could make audible.
+ */
+static constexpr float SILENCE_LEVEL = 1.0e-8f;
+
+template<typename SampleType>
+bool SimpleMBCompAudioProcessor::isSilent(const juce::AudioBuffer<SampleType>& input)
+{
+    //a tile at a time, so audible input is usually found without scanning the whole block
+    const auto numSamples = input.getNumSamples();
+    const auto tileSize = static_cast<int>(SimpleMBComp::TILE_SIZE);
+    for( int ch = 0; ch < input.getNumChannels(); ++ch )
+    {
+        for( int start = 0; start < numSamples; start += tileSize )
         {
-            bandsAreSoloed = true;
-            break;
+            if( input.getMagnitude(ch, start, juce::jmin(tileSize, numSamples - start)) > static_cast<SampleType>(SILENCE_LEVEL) )
+                return false;
         }
     }
     
-    if( bandsAreSoloed )
+    return true;
+}
+
+void SimpleMBCompAudioProcessor::resetDSP()
+{
+    activeEngine->reset();
+    linearPhaseCrossovers.reset();
+    floatKeys.delay.reset();
+    doubleKeys.delay.reset();
+    
+    for( auto* comps : { &compressors, &sideCompressors } )
     {
-        for( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if( comp.solo->get() )
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
+        for( auto& comp : *comps )
+            comp.reset();
     }
-    else
+}
+
+void SimpleMBCompAudioProcessor::trackGainReduction(size_t numSamples)
+{
+    SimpleMBComp::GainReductionPoint tilePoint;
+    tilePoint.numBands = activeEngine->getNumBands();
+    tilePoint.isMidSide = midSide.get();
+    for( size_t i = 0; i < tilePoint.numBands; ++i )
     {
-        for( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if( ! comp.mute->get() )
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
+        tilePoint.bands[i] = compressors[i].takeGainReduction();
+        if( tilePoint.isMidSide )
+            tilePoint.sideBands[i] = sideCompressors[i].takeGainReduction();
     }
     
-    applyGain(buffer, outputGain);
+    gainReductionDecimator.add(tilePoint, numSamples, gainReductionHistory);
+}
+
+template<typename SampleType>
+juce::dsp::AudioBlock<SampleType> SimpleMBCompAudioProcessor::getKeyTile(const juce::AudioBuffer<SampleType>& sidechain,
+                                                                         size_t start,
+                                                                         size_t numSamples)
+{
+    auto& keys = getKeys<SampleType>();
+    const auto numSidechainChannels = sidechain.getNumChannels();
     
+    for( int ch = 0; ch < keys.tile.getNumChannels(); ++ch )
+    {
+        keys.tile.copyFrom(ch,
+                           0,
+                           sidechain,
+                           juce::jmin(ch, numSidechainChannels - 1),
+                           static_cast<int>(start),
+                           static_cast<int>(numSamples));
+    }
+    
+    auto key = juce::dsp::AudioBlock<SampleType>(keys.tile).getSubBlock(0, numSamples);
+    
+    if( linearPhase.get() )
+        keys.delay.process(0, key, static_cast<size_t>(linearPhaseCrossovers.getLatencyInSamples()));
+    
+    return key;
 }
 
 //==============================================================================
@@ -431,107 +790,104 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::
                                                      gainRange,
                                                      0));
     
-    auto thresholdRange = NormalisableRange<float>(SimpleMBComp::MIN_THRESHOLD, SimpleMBComp::MAX_DB, 1, 1);
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Low_Band),
-                                                     params.at(Names::Threshold_Low_Band),
-                                                     thresholdRange,
-                                                     0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Mid_Band),
-                                                     params.at(Names::Threshold_Mid_Band),
-                                                     thresholdRange,
-                                                     0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_High_Band),
-                                                     params.at(Names::Threshold_High_Band),
-                                                     thresholdRange,
-                                                     0));
+    juce::StringArray bandChoices;
+    for( auto numBands = MIN_BANDS; numBands <= MAX_BANDS; ++numBands )
+    {
+        bandChoices.add( juce::String(numBands) );
+    }
+    
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Number_Of_Bands),
+                                                      params.at(Names::Number_Of_Bands),
+                                                      bandChoices,
+                                                      bandChoices.indexOf("3")));
+    
+    juce::StringArray oversamplingChoices;
+    for( size_t order = 0; order <= MAX_OVERSAMPLING_ORDER; ++order )
+    {
+        oversamplingChoices.add( juce::String(1 << order) + "x" );
+    }
+    
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Oversampling),
+                                                      params.at(Names::Oversampling),
+                                                      oversamplingChoices,
+                                                      0));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Lookahead),
+                                                     params.at(Names::Lookahead),
+                                                     NormalisableRange<float>(0.f, MAX_LOOKAHEAD_MS, 0.1f, 1.f),
+                                                     0.f));
+    
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Crossover_Mode),
+                                                      params.at(Names::Crossover_Mode),
+                                                      StringArray { "Minimum Phase", "Linear Phase" },
+                                                      CrossoverModes::Minimum_Phase));
     
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Stereo_Mode),
+                                                      params.at(Names::Stereo_Mode),
+                                                      StringArray { "Left/Right", "Mid/Side" },
+                                                      StereoModes::Left_Right));
+    
+    auto thresholdRange = NormalisableRange<float>(SimpleMBComp::MIN_THRESHOLD, SimpleMBComp::MAX_DB, 1, 1);
+    auto kneeRange = NormalisableRange<float>(0, 24, 0.5f, 1);
     auto attackReleaseRange = NormalisableRange<float>(5, 500, 1, 1);
     
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Low_Band),
-                                                     params.at(Names::Attack_Low_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Mid_Band),
-                                                     params.at(Names::Attack_Mid_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_High_Band),
-                                                     params.at(Names::Attack_High_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Low_Band),
-                                                     params.at(Names::Release_Low_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Mid_Band),
-                                                     params.at(Names::Release_Mid_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_High_Band),
-                                                     params.at(Names::Release_High_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    
-    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 50, 100 };
-    juce::StringArray sa;
-    for( auto choice : choices )
-    {
-        sa.add( juce::String(choice, 1) );
-    }
-    
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Low_Band),
-                                                      params.at(Names::Ratio_Low_Band),
-                                                      sa,
-                                                      3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Mid_Band),
-                                                      params.at(Names::Ratio_Mid_Band),
-                                                      sa,
-                                                      3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_High_Band),
-                                                      params.at(Names::Ratio_High_Band),
-                                                      sa,
-                                                      3));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_Low_Band),
-                                                    params.at(Names::Bypassed_Low_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_Mid_Band),
-                                                    params.at(Names::Bypassed_Mid_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_High_Band),
-                                                    params.at(Names::Bypassed_High_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Low_Band),
-                                                    params.at(Names::Mute_Low_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Mid_Band),
-                                                    params.at(Names::Mute_Mid_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_High_Band),
-                                                    params.at(Names::Mute_High_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Low_Band),
-                                                    params.at(Names::Solo_Low_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Mid_Band),
-                                                    params.at(Names::Solo_Mid_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_High_Band),
-                                                    params.at(Names::Solo_High_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Low_Mid_Crossover_Freq),
-                                                     params.at(Names::Low_Mid_Crossover_Freq),
-                                                     NormalisableRange<float>(SimpleMBComp::MIN_FREQUENCY, 999, 1, 1),
-                                                     400));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Mid_High_Crossover_Freq),
-                                                     params.at(Names::Mid_High_Crossover_Freq),
-                                                     NormalisableRange<float>(1000, SimpleMBComp::MAX_FREQUENCY, 1, 1),
-                                                     2000));
+    //the side bands have the same ranges and defaults
+    for( const auto* bandParams : { &GetBandParams(), &GetSideBandParams() } )
+    {
+        for( const auto& names : *bandParams )
+        {
+            layout.add(std::make_unique<AudioParameterFloat>(names.at(BandNames::Threshold),
+                                                             names.at(BandNames::Threshold),
+                                                             thresholdRange,
+                                                             0));
+            layout.add(std::make_unique<AudioParameterFloat>(names.at(BandNames::Knee),
+                                                             names.at(BandNames::Knee),
+                                                             kneeRange,
+                                                             0));
+            layout.add(std::make_unique<AudioParameterFloat>(names.at(BandNames::Attack),
+                                                             names.at(BandNames::Attack),
+                                                             attackReleaseRange,
+                                                             50));
+            layout.add(std::make_unique<AudioParameterFloat>(names.at(BandNames::Release),
+                                                             names.at(BandNames::Release),
+                                                             attackReleaseRange,
+                                                             250));
+            layout.add(std::make_unique<AudioParameterChoice>(names.at(BandNames::Ratio),
+                                                              names.at(BandNames::Ratio),
+                                                              GetRatioChoiceNames(),
+                                                              3));
+            layout.add(std::make_unique<AudioParameterBool>(names.at(BandNames::Bypassed),
+                                                            names.at(BandNames::Bypassed),
+                                                            false));
+            layout.add(std::make_unique<AudioParameterBool>(names.at(BandNames::Mute),
+                                                            names.at(BandNames::Mute),
+                                                            false));
+            layout.add(std::make_unique<AudioParameterBool>(names.at(BandNames::Solo),
+                                                            names.at(BandNames::Solo),
+                                                            false));
+            layout.add(std::make_unique<AudioParameterBool>(names.at(BandNames::Sidechain),
+                                                            names.at(BandNames::Sidechain),
+                                                            false));
+        }
+    }
+    
+    /*
+     the first two keep the old 3-band defaults.
+     the rest are spread across the top of the spectrum.
+     */
+    const std::array<float, MAX_CROSSOVERS> defaultCrossovers { 400, 2000, 5000, 8000, 11000, 14000, 17000 };
+    
+    auto crossoverRange = NormalisableRange<float>(SimpleMBComp::MIN_FREQUENCY, SimpleMBComp::MAX_FREQUENCY, 1, 1);
+    crossoverRange.setSkewForCentre(1000.f);
+    
+    const auto& crossoverParams = GetCrossoverParams();
+    for( size_t i = 0; i < crossoverParams.size(); ++i )
+    {
+        layout.add(std::make_unique<AudioParameterFloat>(crossoverParams[i],
+                                                         crossoverParams[i],
+                                                         crossoverRange,
+                                                         defaultCrossovers[i]));
+    }
     
     return layout;
 }
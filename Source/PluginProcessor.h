@@ -30,6 +30,11 @@ GUI RoadMap:
 
 #include <JuceHeader.h>
 #include "DSP/CompressorBand.h"
+#include "DSP/Fifo.h"
+#include "DSP/GainReductionHistory.h"
+#include "DSP/LevelMeter.h"
+#include "DSP/MultiBandEngine.h"
+#include "DSP/RealtimeSafetyChecker.h"
 #include "DSP/SingleChannelSampleFifo.h"
 
 
@@ -38,7 +43,8 @@ GUI RoadMap:
 //==============================================================================
 /**
 */
-class SimpleMBCompAudioProcessor  : public juce::AudioProcessor
+class SimpleMBCompAudioProcessor  : public juce::AudioProcessor,
+                                     private juce::Timer
 {
 public:
     //==============================================================================
@@ -54,6 +60,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    
+    //hosts with a 64 bit mix engine can hand us their buffers without converting them to float first
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -87,47 +97,168 @@ public:
     SimpleMBComp::SingleChannelSampleFifo<BlockType> leftChannelFifo { SimpleMBComp::Channel::Left };
     SimpleMBComp::SingleChannelSampleFifo<BlockType> rightChannelFifo { SimpleMBComp::Channel::Right };
 
-    std::array<CompressorBand, 3> compressors;
-    CompressorBand& lowBandComp = compressors[0];
-    CompressorBand& midBandComp = compressors[1];
-    CompressorBand& highBandComp = compressors[2];
+    SimpleMBComp::CompressorBands compressors;
+    //the side of every band in mid/side mode
+    SimpleMBComp::CompressorBands sideCompressors;
+    
+    //one frame per processed block, the editor only needs the newest
+    SimpleMBComp::Fifo<SimpleMBComp::MeterFrame> meterFrames;
+    
+    //every band's gain reduction every few ms, so the editor can draw what happened between its timer ticks
+    SimpleMBComp::GainReductionFifo gainReductionHistory;
+    
+    std::array<juce::AudioParameterFloat*, Params::MAX_CROSSOVERS> crossovers {};
+    juce::AudioParameterChoice* numBandsParam { nullptr };
+    juce::AudioParameterChoice* oversamplingParam { nullptr };
+    juce::AudioParameterFloat* lookaheadParam { nullptr };
+    juce::AudioParameterChoice* crossoverModeParam { nullptr };
+    juce::AudioParameterChoice* stereoModeParam { nullptr };
     
-    juce::AudioParameterFloat* lowMidCrossover { nullptr };
-    juce::AudioParameterFloat* midHighCrossover { nullptr };
+    size_t getNumBands() const;
     
-    juce::AudioParameterFloat* lowThresholdParam { nullptr };
-    juce::AudioParameterFloat* midThresholdParam { nullptr };
-    juce::AudioParameterFloat* highThresholdParam { nullptr };
+    /*
+     blocks of at least SimpleMBComp::PARALLEL_CHUNK_SIZE samples have their bands compressed
+     on worker threads shared by every instance.  on by default, takes effect from the next prepareToPlay().
+     */
+    void setParallelBandsEnabled(bool shouldBeEnabled) { parallelBandsEnabled = shouldBeEnabled; }
+    
+    /*
+     once the input has been silent for longer than the tail, everything is reset and skipped
+     until the input comes back.  on by default.
+     */
+    void setIdleEnabled(bool shouldBeEnabled) { idleEnabled = shouldBeEnabled; }
+    bool isIdle() const { return idle; }
 private:
+    SimpleMBComp::BandBuffers filterBuffers;
     
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    //      fc0     fc1
-    Filter  LP1,    AP2,
-            HP1,    LP2,
-                    HP2;
+    //shared by every engine, only one engine runs at a time
+    SimpleMBComp::LinearPhaseCrossovers linearPhaseCrossovers;
     
-//    Filter invAP1, invAP2;
-//    juce::AudioBuffer<float> invAPBuffer;
+    SimpleMBComp::MultiBandEngines engines { SimpleMBComp::createMultiBandEngines(compressors, sideCompressors, filterBuffers, linearPhaseCrossovers) };
+    SimpleMBComp::MultiBandEngineBase* activeEngine { nullptr };
     
+    /*
+     only held once the host announced blocks long enough to use it,
+     so instances that never see them don't start any threads.
+     */
+    std::unique_ptr<juce::SharedResourcePointer<SimpleMBComp::BandWorkerPool>> bandWorkers;
+    bool parallelBandsEnabled { true };
     
+    template<typename SampleType>
+    struct GainStages
+    {
+        juce::dsp::Gain<SampleType> input, output;
+    };
     
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
+    GainStages<float> floatGains;
+    GainStages<double> doubleGains;
+    
+    template<typename SampleType>
+    GainStages<SampleType>& getGains()
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleGains;
+        else
+            return floatGains;
+    }
     
-    juce::dsp::Gain<float> inputGain, outputGain;
     juce::AudioParameterFloat* inputGainParam { nullptr };
     juce::AudioParameterFloat* outputGainParam { nullptr };
+    SimpleMBComp::DirtyValue<float> inputGainDb, outputGainDb;
     
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& dsp)
+    template<typename SampleType, typename U>
+    void applyGain(juce::dsp::AudioBlock<SampleType> block, U& dsp)
     {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
         dsp.process(ctx);
     }
     
+    template<typename SampleType>
+    void prepareBands(const juce::dsp::ProcessSpec& tileSpec);
+    
+    //the sidechain key as wide as the main bus, one tile or chunk at a time
+    template<typename SampleType>
+    struct KeyStage
+    {
+        juce::AudioBuffer<SampleType> tile;
+        SimpleMBComp::SharedDelayLine<SampleType> delay;
+    };
+    
+    KeyStage<float> floatKeys;
+    KeyStage<double> doubleKeys;
+    
+    template<typename SampleType>
+    KeyStage<SampleType>& getKeys()
+    {
+        if constexpr( std::is_same_v<SampleType, double> )
+            return doubleKeys;
+        else
+            return floatKeys;
+    }
+    
+    bool usesSidechain { false };
+    
+    template<typename SampleType>
+    juce::dsp::AudioBlock<SampleType> getKeyTile(const juce::AudioBuffer<SampleType>& sidechain, size_t start, size_t numSamples);
+    
+    template<typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer);
+    
+    /*
+     how many samples in a row the input has been silent.
+     past the tail every filter, delay and envelope has decayed, so they are reset to exactly zero
+     and neither the DSP nor the analyzer runs until the input is audible again.
+     */
+    size_t silentSamples { 0 };
+    bool idle { false };
+    bool idleEnabled { true };
+    
+    template<typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& input);
+    void resetDSP();
+    
+    SimpleMBComp::GainReductionDecimator gainReductionDecimator;
+    void trackGainReduction(size_t numSamples);
+    
+    /*
+     every parameter the block needs, read once at the top of process().
+     the engine keeps pointing into it until the next block.
+     */
+    SimpleMBComp::ProcessingSnapshot snapshot;
+    SimpleMBComp::ProcessingSnapshot readParameters() const;
+    
     void updateState();
+    double getTailSeconds(float longestReleaseMs) const;
+    
+    SimpleMBComp::DirtyValue<int> oversamplingOrder;
+    SimpleMBComp::DirtyValue<float> lookaheadMs;
+    SimpleMBComp::DirtyValue<bool> linearPhase;
+    SimpleMBComp::DirtyValue<bool> midSide;
+    
+    /*
+     every band's lookahead, sized in prepareToPlay() for MAX_LOOKAHEAD_MS at the host rate.
+     only the one for the processing precision is allocated.
+     */
+    SimpleMBComp::SharedDelayLine<float> floatLookaheadDelay;
+    SimpleMBComp::SharedDelayLine<double> doubleLookaheadDelay;
+    size_t maxLookaheadSamples { 0 };
+    size_t getLookaheadSamples() const;
+    void applyLatencySettings();
+    
+    /*
+     the audio thread notices when the oversampling order, lookahead or crossover mode changes
+     and only stores what it found.  posting a message from the audio thread takes a lock,
+     so the message thread polls for it instead and reports the latency to the host.
+     */
+    std::atomic<int> latencyInSamples { 0 };
+    std::atomic<bool> linearPhaseRequested { false };
+    void timerCallback() override;
     
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    /*
+     what the linear-phase splitter gets prepared with when linear phase is switched on while playing.
+     only touched on the message thread, a sample rate of 0 means there is nothing to prepare for.
+     */
+    juce::dsp::ProcessSpec linearPhaseSpec { 0.0, 0, 0 };
     
 #if USE_TEST_OSC
     juce::dsp::Oscillator<float> osc;